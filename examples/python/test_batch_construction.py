@@ -0,0 +1,69 @@
+#Builds the same random graphs and clauses one edge and clause at a time, and with the batch construction functions
+#(Graph.addNodes, Graph.addEdges and AssertClauses, passing lists and array.array buffers), and checks that each
+#pair of solvers gives the same results under the same assumptions.
+from monosat import *
+import array
+import random
+import sys
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 10
+
+def buildAndSolve(seed,batch):
+    random.seed(seed)
+    Monosat().newSolver("-verb=0")
+    g = Graph()
+    n = 12
+    froms = [random.randrange(n) for _ in range(40)]
+    tos = [random.randrange(n) for _ in range(40)]
+    weights = [random.randint(1,5) for _ in range(40)]
+    if batch:
+        g.addNodes(n)
+        if seed%2==0:
+            edges = g.addEdges(array.array('i',froms),array.array('i',tos),array.array('l',weights))
+        else:
+            edges = g.addEdges(froms,tos,weights)
+    else:
+        for _ in range(n):
+            g.addNode()
+        edges = [g.addEdge(a,b,w) for a,b,w in zip(froms,tos,weights)]
+    assert(g.numNodes()==n and len(g.getAllEdges())==len(edges))
+
+    clauses = [[edges[i] if random.random()<0.5 else Not(edges[i]) for i in random.sample(range(len(edges)),random.randint(1,4))] for _ in range(20)]
+    if batch:
+        AssertClauses(clauses)
+    else:
+        for clause in clauses:
+            AssertClause(clause)
+
+    queries = []
+    for _ in range(6):
+        s,t = random.sample(range(n),2)
+        if random.random()<0.5:
+            queries.append(g.reaches(s,t))
+        else:
+            queries.append(g.maxFlowGreaterOrEqualTo(s,t,random.randint(1,8)))
+    results = []
+    for _ in range(8):
+        assumptions = [l if random.random()<0.5 else Not(l) for l in random.sample(queries,2)]
+        result = Solve(assumptions)
+        results.append(result)
+        if result:
+            results.append(tuple(q.value() for q in queries))
+    return results
+
+for seed in range(n_trials):
+    assert(buildAndSolve(seed,True)==buildAndSolve(seed,False))
+
+#Larger graphs can be built in a single call
+Monosat().newSolver("-verb=0")
+g = Graph()
+n = 2000
+first = g.addNodes(n)
+assert(first==0 and g.numNodes()==n)
+edges = g.addEdges(array.array('i',range(n-1)),array.array('i',range(1,n)),1)
+assert(len(edges)==n-1)
+AssertClauses([[e] for e in edges])
+r = g.reaches(0,n-1)
+assert(Solve(r))
+assert(not Solve(Not(r)))
+print("Done")
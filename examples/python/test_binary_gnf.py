@@ -0,0 +1,57 @@
+#Records random graph, bitvector and CNF constraints both as text GNF and as binary GNF (*.gnfb),
+#and checks that reading either recording back gives the same result as the original solver.
+from monosat import *
+from ctypes import c_char_p
+import os
+import random
+import sys
+import tempfile
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 6
+monosat_c = Monosat().monosat_c
+
+def buildAndSolve(seed,output):
+    random.seed(seed)
+    Monosat().newSolver("-verb=0")
+    Monosat().setOutputFile(output)
+    g=Graph()
+    nodes=[g.addNode() for _ in range(10)]
+    for _ in range(25):
+        a,b=random.sample(nodes,2)
+        g.addEdge(a,b,random.randint(1,5))
+    vs=[Var() for _ in range(60)]
+    for _ in range(240):
+        AssertClause([v if random.random()<0.5 else Not(v) for v in random.sample(vs,3)])
+    bv1 = BitVector(4)
+    bv2 = BitVector(4)
+    Assert(bv1 > bv2)
+    Assert(g.reaches(nodes[0],nodes[9]))
+    Assert(Not(g.distance_lt(nodes[0],nodes[9],random.randint(1,4))))
+    return Monosat().solveLimited()
+
+def readAndSolve(filename):
+    S = monosat_c.newSolver_arg(c_char_p(b"-verb=0"))
+    try:
+        monosat_c.readGNF(S,c_char_p(filename.encode('ascii')))
+        r = monosat_c.solveLimited(S)
+        return True if r==0 else False if r==1 else None
+    finally:
+        monosat_c.deleteSolver(S)
+
+tmp = tempfile.mkdtemp()
+for seed in range(n_trials):
+    text = os.path.join(tmp,"%d.gnf"%(seed))
+    binary = os.path.join(tmp,"%d.gnfb"%(seed))
+    expected = buildAndSolve(seed,text)
+    assert(buildAndSolve(seed,binary)==expected)
+    Monosat().newSolver("-verb=0") #closes the output file
+    r_text = readAndSolve(text)
+    r_binary = readAndSolve(binary)
+    print("%d: %s (%d bytes as text, %d as binary)"%(seed,expected,os.path.getsize(text),os.path.getsize(binary)))
+    assert(r_text==expected)
+    assert(r_binary==expected)
+    assert(os.path.getsize(binary)<os.path.getsize(text))
+    os.remove(text)
+    os.remove(binary)
+os.rmdir(tmp)
+print("Done")
@@ -0,0 +1,33 @@
+#Checks that the bulk model accessors (Values, BVValues, Graph.getEnabledEdges and Graph.getEdgeFlows)
+#agree with reading the model one literal, bitvector or edge at a time.
+from monosat import *
+import random
+import sys
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 10
+
+for seed in range(n_trials):
+    random.seed(seed)
+    Monosat().newSolver("-verb=0")
+    g = Graph()
+    n = 10
+    g.addNodes(n)
+    edges = [g.addEdge(random.randrange(n),random.randrange(n),random.randint(1,5)) for _ in range(30)]
+    for _ in range(12):
+        AssertClause([e if random.random()<0.5 else Not(e) for e in random.sample(edges,3)])
+    flows = [g.maxFlowGreaterOrEqualTo(s,t,random.randint(1,6)) for s,t in (random.sample(range(n),2) for _ in range(3))]
+    bvs = [BitVector(4) for _ in range(5)]
+    Assert(bvs[0]+bvs[1]==bvs[2])
+    Assert(bvs[3]<bvs[4])
+    lits = edges + flows + [Var() for _ in range(5)]
+    if not Solve():
+        continue
+    assert(Values(lits)==[l.value() for l in lits])
+    assert(BVValues(bvs)==[bv.value() for bv in bvs])
+    assert(g.getEnabledEdges()==[e.value() for e in edges])
+    bitmap = g.getEnabledEdges(bitmap=True)
+    assert(len(bitmap)==(len(edges)+7)//8)
+    for f in flows:
+        assert(g.getEdgeFlows(f)==[g.getEdgeFlow(f,e) for e in edges])
+        assert(g.getEdgeFlows(f,True)==[g.getEdgeFlow(f,e,True) for e in edges])
+print("Done")
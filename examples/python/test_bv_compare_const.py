@@ -0,0 +1,46 @@
+#Many comparisons of one bitvector to constants, constrained by random clauses and solved under random assumptions.
+#Checks each result against brute force, and that the model is consistent with every comparison.
+import random
+from monosat import *
+import operator
+
+print("begin encode");
+
+seed = random.randint(1,100000)
+
+random.seed(seed)
+print("RandomSeed=" + str(seed))
+
+width=8
+ops=[(operator.lt,"<"),(operator.le,"<="),(operator.gt,">"),(operator.ge,">=")]
+
+for trial in range(10):
+    Monosat().newSolver("-verb=0")
+    bv = BitVector(width)
+    comparisons=[]
+    for i in range(200):
+        op,_ = random.choice(ops)
+        c = random.randint(0,(1<<width)-1)
+        comparisons.append((op(bv,c),op,c))
+
+    clauses=[]
+    for i in range(random.randint(0,12)):
+        clause = [(random.randrange(len(comparisons)),random.random()<0.5) for _ in range(random.randint(1,3))]
+        clauses.append(clause)
+        AssertClause([Not(comparisons[j][0]) if neg else comparisons[j][0] for j,neg in clause])
+
+    def holds(j,neg,value):
+        _,op,c = comparisons[j]
+        return op(value,c)!=neg
+
+    for solve in range(10):
+        assumptions = [(random.randrange(len(comparisons)),random.random()<0.5) for _ in range(random.randint(0,3))]
+        expect = any(all(any(holds(j,neg,value) for j,neg in clause) for clause in clauses) and
+                     all(holds(j,neg,value) for j,neg in assumptions) for value in range(1<<width))
+        result = Solve([Not(comparisons[j][0]) if neg else comparisons[j][0] for j,neg in assumptions])
+        assert(result==expect)
+        if result:
+            value = bv.value()
+            for l,op,c in comparisons:
+                assert(l.value()==op(value,c))
+print("Done")
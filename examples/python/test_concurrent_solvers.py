@@ -0,0 +1,49 @@
+#Solves several GNF files at the same time, each in its own solver and its own thread,
+#and checks that every thread gets the same result as solving the files one after another.
+from monosat import *
+from ctypes import c_char_p
+import os
+import sys
+import threading
+
+gnf_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)),"..","gnf")
+filenames = [os.path.join(gnf_dir,f) for f in ["reach.gnf","diorama_basic.gnf","diorama_reach.gnf","diorama_distance.gnf","diorama_maxflow.gnf"]]
+n_rounds = int(sys.argv[1]) if len(sys.argv)>1 else 4
+
+monosat_c = Monosat().monosat_c
+
+def solveGNF(filename):
+    #The C API is called directly, as the python Monosat() singleton tracks only one current solver.
+    #ctypes releases the GIL during each call, so the solvers really do run concurrently.
+    S = monosat_c.newSolver_arg(c_char_p(b"-verb=0"))
+    try:
+        monosat_c.readGNF(S,c_char_p(filename.encode('ascii')))
+        r = monosat_c.solveLimited(S)
+        return True if r==0 else False if r==1 else None
+    finally:
+        monosat_c.deleteSolver(S)
+
+expected = dict()
+for filename in filenames:
+    expected[filename]=solveGNF(filename)
+    print("%s: %s"%(os.path.basename(filename),expected[filename]))
+
+errors = []
+def run(filename):
+    try:
+        r = solveGNF(filename)
+        if r!=expected[filename]:
+            errors.append("%s: expected %s, got %s"%(filename,expected[filename],r))
+    except Exception as e:
+        errors.append("%s: %s"%(filename,e))
+
+threads = [threading.Thread(target=run,args=(filename,)) for _ in range(n_rounds) for filename in filenames]
+for t in threads:
+    t.start()
+for t in threads:
+    t.join()
+
+for e in errors:
+    print(e)
+assert(len(errors)==0)
+print("Done")
@@ -0,0 +1,148 @@
+#Checks the DRAT proofs written with -drat, in both the binary and the text format, for random unsatisfiable CNFs
+#(with and without preprocessing), by replaying them against the recorded clauses: every added clause must follow
+#by unit propagation, and the proof must end in the empty clause.
+#For problems with theories, the proofs must also contain trusted theory lemma steps.
+from monosat import *
+import os
+import random
+import sys
+import tempfile
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 10
+
+def readBinaryProof(data):
+    steps = []
+    i = 0
+    while i<len(data):
+        step = chr(data[i])
+        assert(step in "adt")
+        i+=1
+        clause = []
+        while True:
+            value = 0
+            shift = 0
+            while True:
+                b = data[i]
+                i+=1
+                value |= (b&0x7F)<<shift
+                shift+=7
+                if b<0x80:
+                    break
+            if value==0:
+                break
+            clause.append(value//2 if value%2==0 else -(value//2))
+        steps.append((step,clause))
+    return steps
+
+def readTextProof(data):
+    steps = []
+    for line in data.decode().splitlines():
+        tokens = line.split()
+        step = 'a'
+        if tokens[0] in ('d','t'):
+            step = tokens[0]
+            tokens = tokens[1:]
+        assert(tokens[-1]=='0')
+        steps.append((step,[int(t) for t in tokens[:-1]]))
+    return steps
+
+def unitPropagationRefutes(clauses,assignment):
+    #naive unit propagation; returns true on conflict
+    assignment = set(assignment)
+    changed = True
+    while changed:
+        changed = False
+        for clause in clauses:
+            unassigned = []
+            satisfied = False
+            for l in clause:
+                if l in assignment:
+                    satisfied = True
+                    break
+                if -l not in assignment:
+                    unassigned.append(l)
+            if satisfied:
+                continue
+            if len(unassigned)==0:
+                return True
+            if len(unassigned)==1:
+                assignment.add(unassigned[0])
+                changed = True
+    return False
+
+def checkProof(cnf,steps):
+    clauses = [list(c) for c in cnf]
+    for (step,clause) in steps:
+        if step=='d':
+            for c in clauses:
+                if sorted(c)==sorted(clause):
+                    clauses.remove(c)
+                    break
+            continue
+        if step=='a':
+            assert(unitPropagationRefutes(clauses,[-l for l in clause]))
+        clauses.append(clause)
+        if len(clause)==0:
+            return True
+    return False
+
+def readClauses(path):
+    cnf = []
+    for line in open(path):
+        tokens = line.split()
+        if tokens and all(t.lstrip('-').isdigit() for t in tokens) and tokens[-1]=='0':
+            cnf.append([int(t) for t in tokens[:-1]])
+    return cnf
+
+tmpdir = tempfile.mkdtemp()
+proof_path = os.path.join(tmpdir,"proof.drat")
+gnf_path = os.path.join(tmpdir,"problem.gnf")
+
+for seed in range(n_trials):
+    random.seed(seed)
+    binary = seed%2==0
+    pre = "-pre" if seed%4<2 else "-no-pre"
+    Monosat().newSolver("-verb=0 %s -drat=%s %s"%(pre,proof_path,"-drat-binary" if binary else "-no-drat-binary"))
+    Monosat().setOutputFile(gnf_path)
+    n = 12
+    vars = [Var() for _ in range(n)]
+    #random 3-CNF, well above the satisfiability threshold
+    for _ in range(90):
+        AssertClause([v if random.random()<0.5 else Not(v) for v in random.sample(vars,3)])
+    result = Solve()
+    Monosat().setOutputFile("")
+    data = open(proof_path,"rb").read()
+    steps = readBinaryProof(data) if binary else readTextProof(data)
+    if not result:
+        assert(checkProof(readClauses(gnf_path),steps))
+    assert(all(step!='t' for (step,_) in steps))
+
+#pigeon hole: 6 pigeons, 5 holes
+Monosat().newSolver("-verb=0 -drat=%s -drat-binary"%(proof_path))
+Monosat().setOutputFile(gnf_path)
+p = [[Var() for _ in range(5)] for _ in range(6)]
+for i in range(6):
+    AssertClause(p[i])
+for h in range(5):
+    for i in range(6):
+        for j in range(i+1,6):
+            AssertClause([Not(p[i][h]),Not(p[j][h])])
+assert(not Solve())
+Monosat().setOutputFile("")
+assert(checkProof(readClauses(gnf_path),readBinaryProof(open(proof_path,"rb").read())))
+
+#theory conflicts appear as trusted lemmas
+Monosat().newSolver("-verb=0 -drat=%s -no-drat-binary"%(proof_path))
+g = Graph()
+g.addNodes(6)
+edges = dict(((i,j),g.addEdge(i,j,1)) for i in range(6) for j in range(6) if i!=j)
+Assert(g.reaches(0,5))
+#5 can only be reached from 4, which can only be reached from 3, which can't be reached
+for (i,j),e in edges.items():
+    if (j==5 and i!=4) or (j==4 and i!=3) or j==3:
+        Assert(Not(e))
+assert(not Solve())
+steps = readTextProof(open(proof_path,"rb").read())
+assert(any(step=='t' for (step,_) in steps))
+assert(steps[-1]==('a',[]))
+print("Done")
@@ -0,0 +1,72 @@
+#Solves many random maximum flow constraints over different source and sink pairs in the same graph, under random assumptions,
+#with and without -maxflow-cut-tree, and checks each model against a maximum flow computed from the enabled edges.
+from monosat import *
+import random
+import sys
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 10
+
+def maxflow(n,edges,s,t):
+    cap = {}
+    adj = [set() for _ in range(n)]
+    for a,b,w in edges:
+        if a!=b:
+            cap[(a,b)] = cap.get((a,b),0) + w
+            cap.setdefault((b,a),0)
+            adj[a].add(b)
+            adj[b].add(a)
+    flow = 0
+    while True:
+        prev = {s:s}
+        q = [s]
+        for u in q:
+            for v in adj[u]:
+                if v not in prev and cap[(u,v)]>0:
+                    prev[v] = u
+                    q.append(v)
+        if t not in prev:
+            return flow
+        m = None
+        v = t
+        while v!=s:
+            m = cap[(prev[v],v)] if m is None else min(m,cap[(prev[v],v)])
+            v = prev[v]
+        v = t
+        while v!=s:
+            cap[(prev[v],v)] -= m
+            cap[(v,prev[v])] += m
+            v = prev[v]
+        flow += m
+
+def buildAndSolve(seed,opts):
+    random.seed(seed)
+    Monosat().newSolver("-verb=0 " + opts)
+    g = Graph()
+    n = 10
+    nodes = [g.addNode() for _ in range(n)]
+    edges = []
+    for _ in range(30):
+        a,b = random.randrange(n),random.randrange(n)
+        w = random.randint(1,5)
+        edges.append((a,b,w,g.addEdge(nodes[a],nodes[b],w)))
+    for _ in range(15):
+        AssertClause([e if random.random()<0.5 else Not(e) for _,_,_,e in random.sample(edges,3)])
+    flows = []
+    for _ in range(12):
+        s,t = random.sample(range(n),2)
+        k = random.randint(1,8)
+        flows.append((s,t,k,g.maxFlowGreaterOrEqualTo(nodes[s],nodes[t],k)))
+    results = []
+    for _ in range(8):
+        assumptions = [l if random.random()<0.5 else Not(l) for _,_,_,l in random.sample(flows,4)]
+        result = Solve(assumptions)
+        results.append(result)
+        if result:
+            enabled = [(a,b,w) for a,b,w,e in edges if e.value()]
+            for s,t,k,l in flows:
+                assert(l.value()==(maxflow(n,enabled,s,t)>=k))
+    return results
+
+for seed in range(n_trials):
+    assert(buildAndSolve(seed,"-maxflow-cut-tree")==buildAndSolve(seed,""))
+print("Done")
@@ -0,0 +1,34 @@
+#Solves random graph and CNF constraints with a portfolio of solvers,
+#and checks that each result matches that of a single solver.
+from monosat import *
+import random
+import sys
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 6
+
+def buildAndSolve(seed,portfolio):
+    random.seed(seed)
+    Monosat().newSolver("-verb=0 -portfolio=3" if portfolio else "-verb=0")
+    g=Graph()
+    nodes=[g.addNode() for _ in range(12)]
+    for _ in range(30):
+        a,b=random.sample(nodes,2)
+        g.addEdge(a,b)
+    vs=[Var() for _ in range(100)]
+    for _ in range(430):
+        AssertClause([v if random.random()<0.5 else Not(v) for v in random.sample(vs,3)])
+    reach = g.reaches(nodes[0],nodes[11])
+    Assert(reach)
+    Assert(Not(g.reaches(nodes[1],nodes[10])))
+    r = Monosat().solvePortfolio(3) if portfolio else Monosat().solveLimited()
+    if r:
+        #the model of the winning worker is available in the main solver
+        assert(reach.value())
+    return r
+
+for seed in range(n_trials):
+    expected = buildAndSolve(seed,False)
+    r = buildAndSolve(seed,True)
+    print("%d: %s"%(seed,r))
+    assert(r==expected)
+print("Done")
@@ -0,0 +1,47 @@
+#Solves random graph and CNF constraints with the alternative restart and phase heuristics
+#(LBD based restarts, stable mode with target phases, and rephasing),
+#and checks that each result and model matches the constraints solved with the default heuristics.
+from monosat import *
+import random
+import sys
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 6
+
+#options are passed explicitly every time, as they persist between solvers
+default_args = "-verb=0 -no-ema-restarts -mode-switch=0 -target-phase=1 -rephase=0"
+heuristic_args = ["-verb=0 -ema-restarts -ema-restart-min=20 -mode-switch=0 -target-phase=1 -rephase=0",
+                  "-verb=0 -no-ema-restarts -mode-switch=100 -stable-rfirst=50 -target-phase=1 -rephase=0",
+                  "-verb=0 -ema-restarts -ema-restart-min=20 -mode-switch=100 -stable-rfirst=50 -target-phase=1 -rephase=150",
+                  "-verb=0 -no-ema-restarts -mode-switch=0 -target-phase=2 -rephase=100"]
+
+def buildAndSolve(seed,args):
+    random.seed(seed)
+    Monosat().newSolver(args)
+    g=Graph()
+    nodes=[g.addNode() for _ in range(12)]
+    for _ in range(30):
+        a,b=random.sample(nodes,2)
+        g.addEdge(a,b)
+    vs=[Var() for _ in range(150)]
+    clauses=[]
+    for _ in range(635):
+        clause=[v if random.random()<0.5 else Not(v) for v in random.sample(vs,3)]
+        AssertClause(clause)
+        clauses.append(clause)
+    reach = g.reaches(nodes[0],nodes[11])
+    Assert(reach)
+    Assert(Not(g.reaches(nodes[1],nodes[10])))
+    r = Solve()
+    if r:
+        assert(reach.value())
+        for clause in clauses:
+            assert(any(l.value() for l in clause))
+    return r
+
+for seed in range(n_trials):
+    expected = buildAndSolve(seed,default_args)
+    for args in heuristic_args:
+        r = buildAndSolve(seed,args)
+        assert(r==expected)
+    print("%d: %s"%(seed,expected))
+print("Done")
@@ -0,0 +1,66 @@
+#Checks shortest path constraints on graphs with zero-weight edges (including cycles of zero-weight edges) and with bitvector
+#edge weights, which the default dynamic shortest paths algorithm (Ramalingam-Reps) now handles incrementally.
+#Each model is checked against Dijkstra's algorithm, and each result is compared to a solver using -dist=dijkstra.
+from monosat import *
+import heapq
+import random
+import sys
+
+n_trials = int(sys.argv[1]) if len(sys.argv)>1 else 10
+
+def shortestPath(n,edges,s,t):
+    dist = [None]*n
+    dist[s]=0
+    q=[(0,s)]
+    while q:
+        d,u = heapq.heappop(q)
+        if d>dist[u]:
+            continue
+        for (a,b,w) in edges:
+            if a==u and (dist[b] is None or d+w<dist[b]):
+                dist[b]=d+w
+                heapq.heappush(q,(dist[b],b))
+    return dist[t]
+
+def buildAndSolve(seed,args):
+    random.seed(seed)
+    Monosat().newSolver(args)
+    g = Graph()
+    n = 8
+    g.addNodes(n)
+    use_bvs = seed%2==1
+    edges=[]
+    for _ in range(24):
+        a,b = random.randrange(n),random.randrange(n)
+        if use_bvs:
+            w = BitVector(4)
+            Assert(w<=random.randint(0,6))
+        else:
+            w = random.choice([0,0,1,2,3])
+        edges.append((a,b,w,g.addEdge(a,b,w)))
+    #a cycle of zero-weight edges
+    cycle = random.sample(range(n),3)
+    for a,b in zip(cycle,cycle[1:]+cycle[:1]):
+        edges.append((a,b,0,g.addEdge(a,b,0 if not use_bvs else BitVector(4,0))))
+    for _ in range(10):
+        AssertClause([e if random.random()<0.5 else Not(e) for (_,_,_,e) in random.sample(edges,3)])
+    queries = []
+    for _ in range(6):
+        s,t = random.sample(range(n),2)
+        d = random.randint(0,6)
+        queries.append((s,t,d,g.distance_leq(s,t,d)))
+    results = []
+    for _ in range(6):
+        assumptions = [q if random.random()<0.5 else Not(q) for (_,_,_,q) in random.sample(queries,2)]
+        result = Solve(assumptions)
+        results.append(result)
+        if result:
+            enabled = [(a,b,w.value() if isinstance(w,BitVector) else w) for (a,b,w,e) in edges if e.value()]
+            for (s,t,d,q) in queries:
+                dist = shortestPath(n,enabled,s,t)
+                assert(q.value()==(dist is not None and dist<=d))
+    return results
+
+for seed in range(n_trials):
+    assert(buildAndSolve(seed,"-verb=0 -dist=ramal-reps")==buildAndSolve(seed,"-verb=0 -dist=dijkstra"))
+print("Done")
@@ -0,0 +1,89 @@
+/****************************************************************************************[GNFConvert.cc]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+//Converts text GNF (optionally gzipped) to binary GNF, and binary GNF back to text.
+
+#include <cstdio>
+#include <exception>
+#include <zlib.h>
+#include "core/BinaryGNF.h"
+#include "utils/ParseUtils.h"
+using namespace Monosat;
+
+static bool toText(StreamBuffer & strm, FILE * out) {
+	BinaryGNFReader in(strm);
+	vec<char> line;
+	while (in.readLine(line)) {
+		if (fputs(line.begin(), out) < 0)
+			return false;
+	}
+	return fclose(out) == 0;
+}
+
+static bool toBinary(StreamBuffer & in, FILE * out) {
+	BinaryGNFWriter writer(out);
+	static char buf[1 << 16];
+	size_t n = 0;
+	for (; *in != EOF; ++in) {
+		buf[n++] = *in;
+		if (n == sizeof(buf)) {
+			if (!writer.write(buf, n))
+				return false;
+			n = 0;
+		}
+	}
+	if (n > 0 && buf[n - 1] != '\n')
+		buf[n++] = '\n';
+	return writer.write(buf, n) && writer.flush();
+}
+
+int main(int argc, char** argv) {
+	if (argc != 3) {
+		fprintf(stderr, "USAGE: %s <input-file> <output-file>\n"
+				"Converts text GNF (which may be gzipped) to binary GNF, or binary GNF to text GNF.\n", argv[0]);
+		return 1;
+	}
+	gzFile in = gzopen(argv[1], "rb");
+	if (in == nullptr) {
+		fprintf(stderr, "ERROR! Could not open file: %s\n", argv[1]);
+		return 1;
+	}
+	FILE * out = fopen(argv[2], "wb");
+	if (out == nullptr) {
+		fprintf(stderr, "ERROR! Could not open file: %s\n", argv[2]);
+		return 1;
+	}
+	bool ok;
+	try {
+		StreamBuffer strm(in);
+		ok = isBinaryGNF(strm) ? toText(strm, out) : toBinary(strm, out);
+	} catch (const std::exception & e) {
+		fprintf(stderr, "ERROR! Could not read file %s: %s", argv[1], e.what());
+		gzclose(in);
+		return 1;
+	}
+	gzclose(in);
+	if (!ok) {
+		fprintf(stderr, "ERROR! Could not write file: %s\n", argv[2]);
+		return 1;
+	}
+	return 0;
+}
@@ -42,6 +42,7 @@
 #include "amo/AMOTheory.h"
 #include "amo/AMOParser.h"
 #include "core/Optimize.h"
+#include "core/Portfolio.h"
 #include "core/Config.h"
 #include "pb/Config_pb.h"
 using namespace Monosat;
@@ -113,6 +114,8 @@ void selectAlgorithms(){
 		mincutalg = MinCutAlg::ALG_DINITZ_LINKCUT;
 	} else if (!strcasecmp(opt_maxflow_alg, "kohli-torr")) {
 		mincutalg = MinCutAlg::ALG_KOHLI_TORR;
+	} else if (!strcasecmp(opt_maxflow_alg, "push-relabel")) {
+		mincutalg = MinCutAlg::ALG_PUSH_RELABEL;
 	} else {
 		fprintf(stderr, "Error: unknown max-flow/min-cut algorithm %s, aborting\n",
 				((string) opt_maxflow_alg).c_str());
@@ -170,6 +173,8 @@ void selectAlgorithms(){
 		reachalg = ReachAlg::ALG_SAT;
 	} else if (!strcasecmp(opt_reach_alg, "ramal-reps")) {
 		reachalg = ReachAlg::ALG_RAMAL_REPS;
+	} else if (!strcasecmp(opt_reach_alg, "multisource")) {
+		reachalg = ReachAlg::ALG_MULTISOURCE;
 	} else {
 		fprintf(stderr, "Error: unknown reachability algorithm %s, aborting\n", ((string) opt_reach_alg).c_str());
 		exit(1);
@@ -220,6 +225,8 @@ void selectAlgorithms(){
 		allpairsalg = AllPairsAlg::ALG_FLOYDWARSHALL;
 	} else if (!strcasecmp(opt_allpairs_alg, "dijkstra")) {
 		allpairsalg = AllPairsAlg::ALG_DIJKSTRA_ALLPAIRS;
+	} else if (!strcasecmp(opt_allpairs_alg, "incremental")) {
+		allpairsalg = AllPairsAlg::ALG_INCREMENTAL_ALLPAIRS;
 
 	} else {
 		fprintf(stderr, "Error: unknown allpairs reachability algorithm %s, aborting\n",
@@ -455,6 +462,27 @@ void processDecidable(SimpSolver & S, string dstr){
 
 
 
+//Parse the whole input into S, running any solve statements before its last line (unless ignore_solves is set)
+template<class In>
+static void parseInput(In & strm, Dimacs<StreamBuffer, SimpSolver> & parser, SimpSolver & S, bool ignore_solves, bool & found_optimal){
+	while(S.okay() && parser.parse(strm, S)){
+		if(*strm==EOF){
+			//Don't run solves from the last line of the file, in order to support pre-processing and other options below.
+			//(This is not a great way to deal with preprocessing...)
+			break;
+		}
+		if(!ignore_solves){
+			S.preprocess();//do this _even_ if sat based preprocessing is disabled! Some of the theory solvers depend on a preprocessing call being made!
+			if(!opt_remap_vars){
+				fprintf(stderr,"Warning: Solver will give completely bogus answers if 'solve' statements are processed while variable remapping is disabled (e.g., -no-remap-vars)\n\n");
+			}
+			optimize_and_solve(S,parser.assumptions,parser.objectives,false, found_optimal);
+		}else{
+			parser.assumptions.clear();
+		}
+	}
+}
+
 int main(int argc, char** argv) {
 	try {
 		setUsageHelp(
@@ -576,9 +604,20 @@ int main(int argc, char** argv) {
 		if (!opt_pre)
 			S.eliminate(true);
 
-		gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-		if (in == NULL)
-			printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
+		if (strlen(opt_drat_file) > 0) {
+			FILE * proof = fopen(opt_drat_file, opt_drat_binary ? "wb" : "w");
+			if (proof == NULL)
+				printf("ERROR! Could not open proof file: %s\n", (const char*) opt_drat_file), exit(1);
+			S.setProofWriter(new DratWriter(proof, opt_drat_binary));
+		}
+
+		MappedBuffer * mapped = (argc > 1 && opt_parse_threads >= 0) ? MappedBuffer::open(argv[1], opt_parse_threads) : nullptr;
+		gzFile in = nullptr;
+		if (!mapped) {
+			in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
+			if (in == NULL)
+				printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
+		}
 
 		if (opt_verb > 0) {
 			printf("============================[ Problem Statistics ]=============================\n");
@@ -618,25 +657,23 @@ int main(int argc, char** argv) {
 #endif
 		vec<Lit> assume;
 
-		StreamBuffer strm(in);
 		bool found_optimal=true;
-		while(S.okay() && parser.parse(strm, S)){
-			if(*strm==EOF){
-				//Don't run solves from the last line of the file, in order to support pre-processing and other options below.
-				//(This is not a great way to deal with preprocessing...)
-				break;
+		if (mapped) {
+			parseInput(*mapped, parser, S, opt_ignore_solve_statements, found_optimal);
+			if (opt_verb > 0) {
+				printf("Clauses tokenized in parallel = %ld\n", (long) mapped->stats_pretokenized_clauses);
 			}
-			if(!opt_ignore_solve_statements){
-				S.preprocess();//do this _even_ if sat based preprocessing is disabled! Some of the theory solvers depend on a preprocessing call being made!
-				if(!opt_remap_vars){
-					fprintf(stderr,"Warning: Solver will give completely bogus answers if 'solve' statements are processed while variable remapping is disabled (e.g., -no-remap-vars)\n\n");
-				}
-				optimize_and_solve(S,parser.assumptions,parser.objectives,false, found_optimal);
-			}else{
-				parser.assumptions.clear();
+			delete mapped;
+		} else {
+			StreamBuffer strm(in);
+			if (isBinaryGNF(strm)) {
+				BinaryGNFReader binary(strm);
+				parseInput(binary, parser, S, opt_ignore_solve_statements, found_optimal);
+			} else {
+				parseInput(strm, parser, S, opt_ignore_solve_statements, found_optimal);
 			}
+			gzclose(in);
 		}
-		gzclose(in);
 
 		vec<std::pair<int, std::string> > & symbols  = symbolParser.getSymbols();
 		processSymbols( symbols,assume,opt_assume,opt_assume_symbols, using_symbols_asp);
@@ -686,7 +723,91 @@ int main(int argc, char** argv) {
 
 
 
-		lbool ret = optimize_and_solve(S,parser.assumptions,parser.objectives,false,found_optimal);
+		lbool ret = l_Undef;
+		if (opt_portfolio > 1 && argc > 1) {
+			//Each worker of the portfolio re-reads the input file into its own solver.
+			//Learnt clauses are not shared while optimizing, as optimization adds clauses that only hold for the current bounds.
+			Portfolio portfolio(opt_portfolio, parser.objectives.size() ? 0 : (int) opt_portfolio_share);
+			PortfolioMember main_member(portfolio, 0);
+			for (Var v = 0; v < S.nVars(); v++) {
+				Var e = parser.unmap(v);
+				if (e != var_Undef)
+					main_member.mapVar(v, e);
+			}
+			ret = portfolio.solve(S, main_member, [&](bool & optimal) {
+				return optimize_and_solve(S,parser.assumptions,parser.objectives,false,optimal);
+			}, [&](SimpSolver & W, PortfolioMember & member, bool & optimal) {
+				W.min_decision_var = S.min_decision_var;
+				W.max_decision_var = S.max_decision_var;
+				W.min_priority_var = S.min_priority_var;
+				W.max_priority_var = S.max_priority_var;
+				W.setPBSolver(new PB::PbSolver(W));
+				if (!opt_pre)
+					W.eliminate(true);
+				MappedBuffer * wmapped = opt_parse_threads >= 0 ? MappedBuffer::open(argv[1], 1) : nullptr;
+				gzFile win = wmapped ? nullptr : gzopen(argv[1], "rb");
+				if (!wmapped && win == NULL)
+					return l_Undef;
+				Dimacs<StreamBuffer, SimpSolver> wparser;
+				BVParser<char *, SimpSolver> wbvParser;
+				wparser.addParser(&wbvParser);
+				SymbolParser<char*,SimpSolver> wsymbolParser;
+				wparser.addParser(&wsymbolParser);
+				GraphParser<char *, SimpSolver> wgraphParser(precise,wbvParser.theory);
+				wparser.addParser(&wgraphParser);
+				PBParser<char *, SimpSolver> wpbParser(W);
+				wparser.addParser(&wpbParser);
+				FSMParser<char*,SimpSolver> wfsmParser;
+				wparser.addParser(&wfsmParser);
+				LSystemParser<char*,SimpSolver> wlparser;
+				wparser.addParser(&wlparser);
+				AMOParser<char *, SimpSolver> wamo;
+				wparser.addParser(&wamo);
+				GeometryParser<char *, SimpSolver> wgeometryParser;
+				wparser.addParser(&wgeometryParser);
+
+				//the main solver has already run any intermediate solve statements
+				if (wmapped) {
+					while(W.okay() && wparser.parse(*wmapped, W) && **wmapped!=EOF){
+					}
+					delete wmapped;
+				} else {
+					StreamBuffer wstrm(win);
+					if (isBinaryGNF(wstrm)) {
+						BinaryGNFReader wbinary(wstrm);
+						while(W.okay() && wparser.parse(wbinary, W) && *wbinary!=EOF){
+						}
+					} else {
+						while(W.okay() && wparser.parse(wstrm, W) && *wstrm!=EOF){
+						}
+					}
+					gzclose(win);
+				}
+
+				vec<Lit> wassume;
+				processSymbols(wsymbolParser.getSymbols(),wassume,opt_assume,opt_assume_symbols, using_symbols_asp);
+				processPriority(W,(const char *) opt_priority);
+				processDecidable(W , (const char*) opt_decidable);
+				for (Lit l:wassume)
+					wparser.assumptions.push(l);
+				for (Var v = 0; v < W.nVars(); v++) {
+					Var e = wparser.unmap(v);
+					if (e != var_Undef)
+						member.mapVar(v, e);
+				}
+				W.preprocess();
+				if (opt_pre){
+					for (Lit l:wparser.assumptions)
+						W.freezeVar(var(l));
+					W.eliminate(true);
+				}
+				return optimize_and_solve(W,wparser.assumptions,wparser.objectives,false,optimal);
+			}, found_optimal);
+		} else {
+			if (opt_portfolio > 1)
+				fprintf(stderr, "Warning: portfolio solving requires an input file (rather than stdin); solving with a single thread\n");
+			ret = optimize_and_solve(S,parser.assumptions,parser.objectives,false,found_optimal);
+		}
 		double solving_time = rtime(0) - after_preprocessing;
 		if (opt_verb > 0) {
 			printf("Solving time = %f\n", solving_time);
@@ -119,7 +119,7 @@ bool Solve(Lit p, Lit q, Lit r) {
 }
 
 bool Solve() {
-    static vec<Lit> ignore;
+    static thread_local vec<Lit> ignore;
     return Solve(ignore);
 }
 
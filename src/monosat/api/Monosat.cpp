@@ -30,15 +30,22 @@
 #include "monosat/amo/AMOTheory.h"
 #include "Monosat.h"
 #include "monosat/core/Dimacs.h"
+#include "monosat/core/BinaryGNF.h"
 #include "monosat/bv/BVParser.h"
 #include "monosat/graph/GraphParser.h"
 #include "monosat/amo/AMOParser.h"
 #include "monosat/core/Optimize.h"
+#include "monosat/core/Portfolio.h"
 #include "monosat/pb/PbSolver.h"
+#include "monosat/pb/PbParser.h"
+#include "monosat/fsm/FSMParser.h"
 #include <csignal>
+#include <unistd.h>
 #include <set>
+#include <mutex>
 #include <iostream>
 #include <string>
+#include <cstring>
 #include <sstream>
 #include <algorithm>
 #include <iterator>
@@ -75,6 +82,12 @@ static bool has_system_mem_limit=false;
 static rlim_t system_mem_limit;
 
 static std::set<Solver*> solvers;
+//Guards solvers, and the resource limits below, which are shared between all solvers of the process.
+//Solvers may be created, solved, and deleted concurrently from different threads.
+static std::mutex solvers_lock;
+//Number of solve calls currently in progress. The process resource limits are installed by the first of these,
+//and restored once the last has finished.
+static int n_active_solves=0;
 
 static sighandler_t system_sigxcpu_handler = nullptr;
 
@@ -95,9 +108,14 @@ struct initializer {
 };
 static initializer i;
 }
-void disableResourceLimits();
+static void restoreResourceLimits();
 static void SIGNAL_HANDLER_api(int signum) {
-	disableResourceLimits();
+	//The signal may be delivered to a thread that is currently holding solvers_lock, so don't block on it.
+	//If the lock is unavailable, SIGXCPU will be sent again once the next second of cpu time has elapsed.
+	std::unique_lock<std::mutex> guard(solvers_lock,std::try_to_lock);
+	if(!guard.owns_lock())
+		return;
+	restoreResourceLimits();
 	printf("Interupting solver due to resource limit\n");
 	fflush(stdout);
 	for(Solver* solver:solvers)
@@ -107,6 +125,11 @@ static void SIGNAL_HANDLER_api(int signum) {
 
 
 void enableResourceLimits(){
+	std::lock_guard<std::mutex> guard(solvers_lock);
+	if(n_active_solves++>0){
+		//another solver has already installed the limits
+		return;
+	}
 	struct rusage ru;
 	getrusage(RUSAGE_SELF, &ru);
 	__time_t cur_time = ru.ru_utime.tv_sec;
@@ -158,6 +181,16 @@ void enableResourceLimits(){
 }
 
 void disableResourceLimits(){
+	std::lock_guard<std::mutex> guard(solvers_lock);
+	if(n_active_solves>0 && --n_active_solves>0){
+		//other solvers are still running under these limits
+		return;
+	}
+	restoreResourceLimits();
+}
+
+//Caller must hold solvers_lock
+static void restoreResourceLimits(){
 	rlimit rl;
 	getrlimit(RLIMIT_CPU, &rl);
 	if(has_system_time_limit){
@@ -219,6 +252,8 @@ void _selectAlgorithms(){
 		mincutalg = MinCutAlg::ALG_DINITZ_LINKCUT;
 	} else if (!strcasecmp(opt_maxflow_alg, "kohli-torr")) {
 		mincutalg = MinCutAlg::ALG_KOHLI_TORR;
+	} else if (!strcasecmp(opt_maxflow_alg, "push-relabel")) {
+		mincutalg = MinCutAlg::ALG_PUSH_RELABEL;
 	} else {
 		api_errorf( "Error: unknown max-flow/min-cut algorithm %s, aborting\n",
 					((string) opt_maxflow_alg).c_str());
@@ -276,6 +311,8 @@ void _selectAlgorithms(){
 		reachalg = ReachAlg::ALG_SAT;
 	} else if (!strcasecmp(opt_reach_alg, "ramal-reps")) {
 		reachalg = ReachAlg::ALG_RAMAL_REPS;
+	} else if (!strcasecmp(opt_reach_alg, "multisource")) {
+		reachalg = ReachAlg::ALG_MULTISOURCE;
 	} else {
 		api_errorf( "Error: unknown reachability algorithm %s, aborting\n", ((string) opt_reach_alg).c_str());
 
@@ -326,6 +363,8 @@ void _selectAlgorithms(){
 		allpairsalg = AllPairsAlg::ALG_FLOYDWARSHALL;
 	} else if (!strcasecmp(opt_allpairs_alg, "dijkstra")) {
 		allpairsalg = AllPairsAlg::ALG_DIJKSTRA_ALLPAIRS;
+	} else if (!strcasecmp(opt_allpairs_alg, "incremental")) {
+		allpairsalg = AllPairsAlg::ALG_INCREMENTAL_ALLPAIRS;
 
 	} else {
 		api_errorf(  "Error: unknown allpairs reachability algorithm %s, aborting\n",
@@ -367,22 +406,92 @@ struct MonosatData{
 	bool has_conflict_clause_from_last_solution=false;
 	vec<Objective> optimization_objectives;
 	FILE * outfile =nullptr;
+	//Set instead of outfile if the output file is binary GNF
+	BinaryGNFWriter * binary_outfile=nullptr;
 	string args = "";
+	//If the solver was created with -portfolio=<n>, every constraint is also recorded (as binary GNF) to this temporary file,
+	//from which the other workers of a portfolio load their own copies of the problem
+	BinaryGNFWriter * portfolio_record=nullptr;
+	string portfolio_record_path;
+	//False if the recording is missing constraints (such as those read by readGNF)
+	bool portfolio_record_complete=true;
+	int portfolio_workers=0;
 };
 
 //Supporting function for throwing parse errors
 inline void write_out(Monosat::SimpSolver * S, const char *fmt, ...) {
 	MonosatData * d = (MonosatData*) S->_external_data;
-	if (!d || !d->outfile){
+	if (!d || (!d->outfile && !d->binary_outfile && !d->portfolio_record)){
 		return;
 	}
 	va_list args;
-	va_start(args, fmt);
-	if( vfprintf(d->outfile,fmt,args)<0){
+	if(d->outfile){
+		va_start(args, fmt);
+		if( vfprintf(d->outfile,fmt,args)<0){
+			api_errorf("Failed to write output");
+		}
+		va_end(args);
+		fflush(d->outfile);
+	}
+	if(d->binary_outfile || d->portfolio_record){
+		//binary GNF is encoded from the same text
+		static thread_local vec<char> text;
+		text.growTo(256);
+		va_start(args, fmt);
+		int n = vsnprintf(text.begin(),text.size(),fmt,args);
+		va_end(args);
+		if(n>=text.size()){
+			text.growTo(n+1);
+			va_start(args, fmt);
+			n = vsnprintf(text.begin(),text.size(),fmt,args);
+			va_end(args);
+		}
+		if(n<0){
+			api_errorf("Failed to write output");
+		}
+		if(d->binary_outfile && !d->binary_outfile->write(text.begin(),n)){
+			api_errorf("Failed to write output");
+		}
+		if(d->portfolio_record && !d->portfolio_record->write(text.begin(),n)){
+			api_errorf("Failed to write portfolio recording");
+		}
+	}
+}
+
+//Write a clause to the output files (skipping the text formatting for binary output files)
+inline void write_clause(Monosat::SimpSolver * S, const vec<Lit> & clause) {
+	MonosatData * d = (MonosatData*) S->_external_data;
+	if (!d){
+		return;
+	}
+	if(d->outfile){
+		for(Lit l:clause){
+			fprintf(d->outfile,"%d ",dimacs(l));
+		}
+		if(fprintf(d->outfile,"0\n")<0){
+			api_errorf("Failed to write output");
+		}
+		fflush(d->outfile);
+	}
+	if(d->binary_outfile && !d->binary_outfile->writeClause(clause)){
 		api_errorf("Failed to write output");
 	}
-	va_end(args);
-	fflush(d->outfile);
+	if(d->portfolio_record && !d->portfolio_record->writeClause(clause)){
+		api_errorf("Failed to write portfolio recording");
+	}
+}
+
+static void startPortfolioRecording(Monosat::SimpSolver * S, int n_workers){
+	MonosatData * d = (MonosatData*) S->_external_data;
+	char path[] = "/tmp/monosat_portfolio_XXXXXX";
+	int fd = mkstemp(path);
+	FILE * record = fd>=0 ? fdopen(fd,"wb") : nullptr;
+	if(!record){
+		api_errorf("Failed to create portfolio recording %s",path);
+	}
+	d->portfolio_record = new BinaryGNFWriter(record);
+	d->portfolio_record_path=path;
+	d->portfolio_workers=n_workers;
 }
 
 void setOutputFile(Monosat::SimpSolver * S, char * output){
@@ -392,8 +501,21 @@ void setOutputFile(Monosat::SimpSolver * S, char * output){
 		fclose(d->outfile);
 		d->outfile=nullptr;
 	}
+	if(d->binary_outfile){
+		delete d->binary_outfile;
+		d->binary_outfile=nullptr;
+	}
 	if (output && strlen(output)>0) {
-		d->outfile = fopen(output, "w");
+		//files named *.gnfb are written as binary GNF
+		size_t len = strlen(output);
+		if(len>5 && strcmp(output+len-5,".gnfb")==0){
+			FILE * f = fopen(output, "wb");
+			if(f){
+				d->binary_outfile = new BinaryGNFWriter(f);
+			}
+		}else{
+			d->outfile = fopen(output, "w");
+		}
 	}
 	write_out(S,"c monosat %s\n",d->args.c_str());
 	if(S->const_true!=lit_Undef){
@@ -455,6 +577,8 @@ Monosat::SimpSolver * newSolver_arg(char*argv){
 
 Monosat::SimpSolver * newSolver_args(int argc, char**argv){
 	using namespace APISignal;
+	//Options are parsed into globals before being copied into the new solver, so solvers must be created one at a time.
+	std::lock_guard<std::mutex> guard(solvers_lock);
 	string args ="";
 	for (int i = 0;i<argc;i++){
 		args.append(" ");
@@ -473,8 +597,18 @@ Monosat::SimpSolver * newSolver_args(int argc, char**argv){
 		opt_write_learnt_clauses=nullptr;
 	}
 	_selectAlgorithms();
-	Monosat::SimpSolver * S = new Monosat::SimpSolver();
+	FILE * proof = nullptr;
+	if(strlen(opt_drat_file)>0){
+		proof = fopen(opt_drat_file, opt_drat_binary ? "wb":"w");
+		if(!proof){
+			api_errorf("Failed to open proof file %s",(const char*)opt_drat_file);
+		}
+	}
+	Monosat::SimpSolver * S = new Monosat::SimpSolver();//snapshots the options parsed above into S->getConfig()
 	solvers.insert(S);//add S to the list of solvers handled by signals
+	if(proof){
+		S->setProofWriter(new DratWriter(proof,opt_drat_binary));
+	}
 
 
 	S->_external_data =(void*)new MonosatData();
@@ -484,19 +618,34 @@ Monosat::SimpSolver * newSolver_args(int argc, char**argv){
 	}
 	((MonosatData*)S->_external_data)->pbsolver = new PB::PbSolver(*S);
 	S->setPBSolver(((MonosatData*)S->_external_data)->pbsolver);
+	if(opt_portfolio>1){
+		startPortfolioRecording(S,opt_portfolio);
+	}
 	return S ;
 }
 void deleteSolver (Monosat::SimpSolver * S)
 {
 	using namespace APISignal;
 	S->interrupt();
-	solvers.erase(S);//remove S from the list of solvers in the signal handler
+	{
+		std::lock_guard<std::mutex> guard(solvers_lock);
+		solvers.erase(S);//remove S from the list of solvers in the signal handler
+	}
 	if(S->_external_data){
 		MonosatData* data = (MonosatData*) S->_external_data;
 		if(data->outfile){
 			fclose(data->outfile);
 			data->outfile = nullptr;
 		}
+		if(data->binary_outfile){
+			delete data->binary_outfile;
+			data->binary_outfile = nullptr;
+		}
+		if(data->portfolio_record){
+			delete data->portfolio_record;
+			data->portfolio_record = nullptr;
+			unlink(data->portfolio_record_path.c_str());
+		}
 		delete(data);
 		S->_external_data=nullptr;
 	}
@@ -537,7 +686,7 @@ void maximizeLits(Monosat::SimpSolver *  S, int * lits, int n_lits){
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
+	static thread_local vec<Lit> lits_opt;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(toLit(lits[i]));
@@ -554,7 +703,7 @@ void minimizeLits(Monosat::SimpSolver *  S, int * lits, int n_lits){
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
+	static thread_local vec<Lit> lits_opt;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(toLit(lits[i]));
@@ -571,8 +720,8 @@ void maximizeWeightedLits(Monosat::SimpSolver *  S, int * lits, int * weights, i
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
-	static vec<int> weights_opt;
+	static thread_local vec<Lit> lits_opt;
+	static thread_local vec<int> weights_opt;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(toLit(lits[i]));
@@ -603,8 +752,8 @@ void minimizeWeightedLits(Monosat::SimpSolver *  S, int * lits, int * weights, i
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
-	static vec<int> weights_opt;
+	static thread_local vec<Lit> lits_opt;
+	static thread_local vec<int> weights_opt;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(toLit(lits[i]));
@@ -631,28 +780,10 @@ void minimizeWeightedLits(Monosat::SimpSolver *  S, int * lits, int * weights, i
 }
 
 
-void readGNF(Monosat::SimpSolver * S, const char  * filename){
-	bool precise = true;
-
-	gzFile in = gzopen(filename, "rb");
-	if (in == nullptr)
-		throw std::runtime_error("ERROR! Could not open file");
+//Parse strm into S, solving at each of its solve statements (and at the end of the file, if it doesn't end with one)
+template<class In>
+static void readGNF_(Monosat::SimpSolver * S, Dimacs<StreamBuffer, SimpSolver> & parser, In & strm){
 	MonosatData * d = (MonosatData*) S->_external_data;
-
-	Dimacs<StreamBuffer, SimpSolver> parser;
-	BVParser<char *, SimpSolver> bvParser;
-	parser.addParser(&bvParser);
-
-	SymbolParser<char*,SimpSolver> symbolParser;
-	parser.addParser(&symbolParser);
-
-	GraphParser<char *, SimpSolver> graphParser(precise,bvParser.theory);
-	parser.addParser(&graphParser);
-
-	AMOParser<char *, SimpSolver> amo;
-	parser.addParser(&amo);
-
-	StreamBuffer strm(in);
 	vec<int> assumps;
 	bool ran_last_solve=false;
 	d->optimization_objectives.clear();
@@ -683,9 +814,48 @@ void readGNF(Monosat::SimpSolver * S, const char  * filename){
 		solveAssumptions(S,&assumps[0],assumps.size());
 	}
 	d->optimization_objectives.clear();
+}
 
-	gzclose(in);
+void readGNF(Monosat::SimpSolver * S, const char  * filename){
+	bool precise = true;
+
+	MappedBuffer * mapped = opt_parse_threads >= 0 ? MappedBuffer::open(filename, opt_parse_threads) : nullptr;
+	gzFile in = nullptr;
+	if (!mapped) {
+		in = gzopen(filename, "rb");
+		if (in == nullptr)
+			throw std::runtime_error("ERROR! Could not open file");
+	}
+	MonosatData * d = (MonosatData*) S->_external_data;
+	//the contents of the file are not recorded, so this solver can no longer be copied into a portfolio
+	d->portfolio_record_complete=false;
 
+	Dimacs<StreamBuffer, SimpSolver> parser;
+	BVParser<char *, SimpSolver> bvParser;
+	parser.addParser(&bvParser);
+
+	SymbolParser<char*,SimpSolver> symbolParser;
+	parser.addParser(&symbolParser);
+
+	GraphParser<char *, SimpSolver> graphParser(precise,bvParser.theory);
+	parser.addParser(&graphParser);
+
+	AMOParser<char *, SimpSolver> amo;
+	parser.addParser(&amo);
+
+	if (mapped) {
+		readGNF_(S, parser, *mapped);
+		delete mapped;
+	} else {
+		StreamBuffer strm(in);
+		if(isBinaryGNF(strm)){
+			BinaryGNFReader binary(strm);
+			readGNF_(S, parser, binary);
+		}else{
+			readGNF_(S, parser, strm);
+		}
+		gzclose(in);
+	}
 }
 
 Monosat::GraphTheorySolver<int64_t> *  newGraph(Monosat::SimpSolver * S){
@@ -739,7 +909,84 @@ void setPropagationLimit(Monosat::SimpSolver * S,int num_propagations){
 
 
 
-int _solve(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
+//Solve S as worker 0 of a portfolio of n_threads solvers, each other worker loading its own copy of S from the recording.
+//Sets winner to the index of the worker that finished first.
+static lbool _solvePortfolio(Monosat::SimpSolver * S,const vec<Lit> & assume, const vec<Objective> & objectives, int n_threads, bool & found_optimal, int & winner){
+	MonosatData * d = (MonosatData*) S->_external_data;
+	if(!d->portfolio_record->flush()){
+		api_errorf("Failed to write portfolio recording");
+	}
+	const string path = d->portfolio_record_path;
+	const int n_vars = S->nVars();
+	//optimization adds clauses that only hold for the current bounds, so learnt clauses are only shared when not optimizing
+	Portfolio portfolio(n_threads, objectives.size() ? 0 : (int) opt_portfolio_share);
+	PortfolioMember main_member(portfolio,0);
+	//the recording refers to the variables of S directly
+	for (Var v = 0;v<n_vars;v++){
+		main_member.mapVar(v,v);
+	}
+	lbool r = portfolio.solve(*S,main_member,[&](bool & optimal){
+		return optimize_and_solve(*S, assume,objectives,opt_pre,optimal);
+	},[&](SimpSolver & W, PortfolioMember & member, bool & optimal){
+		W.setPBSolver(new PB::PbSolver(W));
+		if(!opt_pre){
+			W.eliminate(true);
+		}
+		gzFile in = gzopen(path.c_str(), "rb");
+		if (in == nullptr)
+			return l_Undef;
+		Dimacs<StreamBuffer, SimpSolver> parser;
+		BVParser<char *, SimpSolver> bvParser;
+		parser.addParser(&bvParser);
+		SymbolParser<char*,SimpSolver> symbolParser;
+		parser.addParser(&symbolParser);
+		GraphParser<char *, SimpSolver> graphParser(true,bvParser.theory);
+		parser.addParser(&graphParser);
+		PBParser<char *, SimpSolver> pbParser(W);
+		parser.addParser(&pbParser);
+		FSMParser<char*,SimpSolver> fsmParser;
+		parser.addParser(&fsmParser);
+		AMOParser<char *, SimpSolver> amo;
+		parser.addParser(&amo);
+		//recorded solve statements (including the one for this solve) are skipped; the assumptions and objectives are mapped from S below
+		{
+			StreamBuffer strm(in);
+			BinaryGNFReader binary(strm);
+			while(W.okay() && parser.parse(binary, W)){
+			}
+		}
+		gzclose(in);
+
+		for(Var e = 0;e<n_vars;e++){
+			Var v = parser.getVarFromExternalVar(e);
+			if(v!=var_Undef && v<W.nVars()){
+				member.mapVar(v,e);
+			}
+		}
+		vec<Lit> worker_assume;
+		for(Lit l:assume){
+			worker_assume.push(mkLit(parser.mapVar(W,var(l)),sign(l)));
+		}
+		vec<Objective> worker_objectives;
+		for(const Objective & o:objectives){
+			if(o.isBV()){
+				worker_objectives.push(Objective(parser.mapBV(W,o.bvID),o.maximize));
+			}else{
+				vec<Lit> lits;
+				for(Lit l:o.pb_lits){
+					lits.push(mkLit(parser.mapVar(W,var(l)),sign(l)));
+				}
+				worker_objectives.push(Objective(lits,o.pb_weights,o.maximize));
+			}
+		}
+		W.preprocess();
+		return optimize_and_solve(W, worker_assume,worker_objectives,opt_pre,optimal);
+	},found_optimal);
+	winner = portfolio.getWinner();
+	return r;
+}
+
+int _solve(Monosat::SimpSolver * S,int * assumptions, int n_assumptions, int n_threads){
 	bool found_optimal=true;
 	MonosatData * d = (MonosatData*) S->_external_data;
 	d->last_solution_optimal=true;
@@ -775,9 +1022,19 @@ int _solve(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
 	if (d->pbsolver) {
 		d->pbsolver->convert();
 	}
-	lbool r = optimize_and_solve(*S, assume,objectives,opt_pre,found_optimal);
+	lbool r;
+	int winner = 0;
+	if(n_threads>1 && d->portfolio_record && d->portfolio_record_complete && !d->csg_theory){
+		r = _solvePortfolio(S, assume,objectives,n_threads,found_optimal,winner);
+	}else{
+		if(n_threads>1){
+			fprintf(stderr,"Warning: portfolio solving requires a solver created with -portfolio=<n>, that has not read a GNF file or created a CSG theory; solving with a single thread\n");
+		}
+		r = optimize_and_solve(*S, assume,objectives,opt_pre,found_optimal);
+	}
 	d->last_solution_optimal=found_optimal;
-	if(r==l_False){
+	if(r==l_False && winner<=0){
+		//(if another worker of a portfolio proved unsatisfiability, no conflict clause is available in S)
 		d->has_conflict_clause_from_last_solution=true;
 	}
 	if (opt_verb >= 1) {
@@ -794,12 +1051,20 @@ int solveLimited(Monosat::SimpSolver * S){
 }
 
 int solveAssumptionsLimited(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
-	return _solve(S, assumptions,  n_assumptions);
+	MonosatData * d = (MonosatData*) S->_external_data;
+	return _solve(S, assumptions,  n_assumptions, d->portfolio_workers);
 	//return solveAssumptionsLimited_MinBVs(S,assumptions,n_assumptions,nullptr,0);
 }
 
 bool solveAssumptions(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
-	return _solve(S,assumptions,n_assumptions);
+	MonosatData * d = (MonosatData*) S->_external_data;
+	return _solve(S,assumptions,n_assumptions, d->portfolio_workers);
+}
+int solvePortfolio(Monosat::SimpSolver * S, int n_threads){
+	return solveAssumptionsPortfolio(S,nullptr,0,n_threads);
+}
+int solveAssumptionsPortfolio(Monosat::SimpSolver * S,int * assumptions, int n_assumptions, int n_threads){
+	return _solve(S,assumptions,n_assumptions,n_threads);
 }
 bool lastSolutionWasOptimal(Monosat::SimpSolver * S){
 	MonosatData * d = (MonosatData*) S->_external_data;
@@ -904,16 +1169,13 @@ int true_lit(Monosat::SimpSolver * S){
 	return toInt(l);
 }
 bool addClause(Monosat::SimpSolver * S,int * lits, int n_lits){
-	static vec<Lit> clause;
+	static thread_local vec<Lit> clause;
 	clause.clear();
 	for (int i = 0;i<n_lits;i++){
 		clause.push(toLit(lits[i]));
 	}
 
-	for(Lit l:clause){
-		write_out(S,"%d ",dimacs(l));
-	}
-	write_out(S,"0\n");
+	write_clause(S,clause);
 	return S->addClause(clause);
 }
 bool addUnitClause(Monosat::SimpSolver * S,int lit){
@@ -930,6 +1192,21 @@ bool addTertiaryClause(Monosat::SimpSolver * S,int lit1, int lit2, int lit3){
 	write_out(S,"%d %d %d 0\n",dimacs(toLit(lit1)), dimacs(toLit(lit2)), dimacs(toLit(lit3)));
 	return S->addClause(toLit(lit1),toLit(lit2),toLit(lit3));
 }
+bool addClauses(Monosat::SimpSolver * S,int * lits, int * offsets, int n_clauses){
+	static thread_local vec<Lit> clause;
+	bool ok = true;
+	for (int i = 0;i<n_clauses;i++){
+		clause.clear();
+		for (int j = offsets[i];j<offsets[i+1];j++){
+			clause.push(toLit(lits[j]));
+		}
+		write_clause(S,clause);
+		if(!S->addClause(clause)){
+			ok=false;
+		}
+	}
+	return ok;
+}
 
 //theory interface for bitvectors
 int newBitvector_anon(Monosat::SimpSolver * S,Monosat::BVTheorySolver<int64_t> * bv, int bvWidth){
@@ -945,8 +1222,14 @@ int newBitvector_const(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t>
 }
 
 
+void newBitvectors_const(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t> * bv, int bvWidth, int64_t * constvals, int n, int * out_bvIDs){
+	for (int i = 0;i<n;i++){
+		out_bvIDs[i] = newBitvector_const(S,bv,bvWidth,constvals[i]);
+	}
+}
+
 int newBitvector(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t> * bv, int * bits, int n_bits){
-	static vec<Var> lits;
+	static thread_local vec<Var> lits;
 	lits.clear();
 	for (int i = 0;i<n_bits;i++){
 		lits.push(Var(bits[i]));
@@ -1184,7 +1467,7 @@ void assertPB(Monosat::SimpSolver * S, int _rhs, int n_args, int * literals, int
 			d->pbsolver = new PB::PbSolver(*S);
 		}
 
-		static vec<Lit> lits;
+		static thread_local vec<Lit> lits;
 		lits.clear();
 		for (int i = 0; i < n_args; i++) {
 			Lit l = toLit(literals[i]);
@@ -1192,7 +1475,7 @@ void assertPB(Monosat::SimpSolver * S, int _rhs, int n_args, int * literals, int
 			write_out(S,"%d ", dimacs(l));
 		}
 		write_out(S,"%d ", n_args);
-		static vec<PB::Int> coefs;
+		static thread_local vec<PB::Int> coefs;
 		coefs.clear();
 		for (int i = 0; i < n_args; i++) {
 			coefs.push(PB::Int(coefficients[i]));
@@ -1248,6 +1531,29 @@ int newEdge_bv(Monosat::SimpSolver * S, Monosat::GraphTheorySolver<int64_t> *G,i
 	return toInt(l);
 }
 
+int newNodes(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int n){
+	int first = G->nNodes();
+	for (int i = 0;i<n;i++){
+		G->newNode();
+	}
+	return first;
+}
+void newEdges(Monosat::SimpSolver * S, Monosat::GraphTheorySolver<int64_t> *G,int * from,int * to,  int64_t * weights, int n, int * out_lits){
+	for (int i = 0;i<n;i++){
+		out_lits[i] = newEdge(S,G,from[i],to[i],weights[i]);
+	}
+}
+void newEdges_double(Monosat::SimpSolver * S, Monosat::GraphTheorySolver<double> *G,int * from,int * to,  double * weights, int n, int * out_lits){
+	for (int i = 0;i<n;i++){
+		out_lits[i] = newEdge_double(S,G,from[i],to[i],weights[i]);
+	}
+}
+void newEdges_bv(Monosat::SimpSolver * S, Monosat::GraphTheorySolver<int64_t> *G,int * from,int * to, int * bvIDs, int n, int * out_lits){
+	for (int i = 0;i<n;i++){
+		out_lits[i] = newEdge_bv(S,G,from[i],to[i],bvIDs[i]);
+	}
+}
+
 int reaches(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int from, int to){
 	Var v = newVar(S);
 	Lit l =mkLit(v);
@@ -1276,7 +1582,7 @@ int shortestPathUnweighted_leq_const(Monosat::SimpSolver * S,Monosat::GraphTheor
 int shortestPath_lt_const(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int from, int to, int64_t dist){
 	Var v = newVar(S);
 	Lit l =mkLit(v);
-	write_out(S,"weighted_distance_lt %d %d %d %d %d %ld\n",G->getGraphID(),from,to, dimacs(l),dist);
+	write_out(S,"weighted_distance_lt %d %d %d %d %ld\n",G->getGraphID(),from,to, dimacs(l),dist);
 	G->distance(from, to, v,dist, false);
 	G->implementConstraints();
 	return toInt(l);
@@ -1284,7 +1590,7 @@ int shortestPath_lt_const(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int
 int shortestPath_leq_const(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int from, int to, int64_t dist){
 	Var v = newVar(S);
 	Lit l =mkLit(v);
-	write_out(S,"weighted_distance_leq %d %d %d %d %d %ld\n",G->getGraphID(),from,to, dimacs(l),dist);
+	write_out(S,"weighted_distance_leq %d %d %d %d %ld\n",G->getGraphID(),from,to, dimacs(l),dist);
 	G->distance(from, to, v,dist, true);
 	G->implementConstraints();
 	return toInt(l);
@@ -1547,6 +1853,16 @@ int64_t getModel_BV(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t> *
 	}
 
 }
+void getModel_Literals(Monosat::SimpSolver * S,int * lits, int n_lits, int * store){
+	for(int i = 0;i<n_lits;i++){
+		store[i]=getModel_Literal(S,lits[i]);
+	}
+}
+void getModel_BVs(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t> * bv, int * bvIDs, int n_bvs, bool getMaximumValue, int64_t * store){
+	for(int i = 0;i<n_bvs;i++){
+		store[i]=getModel_BV(S,bv,bvIDs[i],getMaximumValue);
+	}
+}
 //graph queries:
 int getModel_Path_Nodes_Length(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int reach_or_distance_literal){
 	Lit l = toLit(reach_or_distance_literal);
@@ -1609,6 +1925,35 @@ int64_t getModel_AcyclicEdgeFlow(Monosat::SimpSolver * S,Monosat::GraphTheorySol
 	return G->getModel_MaximumFlow_AcyclicEdgeFlow(S->getTheoryLit(l),S->getTheoryLit(e));
 }
 
+int getModel_EdgeFlows(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int maxflow_literal, int store_length, int64_t * store){
+	Lit l = toLit(maxflow_literal);
+	if(store_length<G->nEdges()){
+		return G->nEdges();
+	}
+	return G->getModel_MaximumFlow_EdgeFlows(S->getTheoryLit(l),store,false) ? G->nEdges() : -1;
+}
+int getModel_AcyclicEdgeFlows(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int maxflow_literal, int store_length, int64_t * store){
+	Lit l = toLit(maxflow_literal);
+	if(store_length<G->nEdges()){
+		return G->nEdges();
+	}
+	return G->getModel_MaximumFlow_EdgeFlows(S->getTheoryLit(l),store,true) ? G->nEdges() : -1;
+}
+int getModel_EnabledEdges(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G, int store_length, unsigned char * store){
+	int n_edges = G->nEdges();
+	if(store_length*8<n_edges){
+		return n_edges;
+	}
+	memset(store,0,(n_edges+7)/8);
+	for(int edgeID = 0;edgeID<n_edges;edgeID++){
+		Var v = var(G->toSolver(mkLit(G->getEdgeVar(edgeID))));
+		if(v<S->model.size() && S->model[v]==l_True){
+			store[edgeID/8] |= (1<<(edgeID%8));
+		}
+	}
+	return n_edges;
+}
+
 int64_t getModel_MinimumSpanningTreeWeight(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int spanning_tree_literal){
 	Lit l = toLit(spanning_tree_literal);
 	return G->getModel_MinimumSpanningWeight(S->getTheoryLit(l));
@@ -76,7 +76,8 @@ typedef int64_t Weight;
 #endif
 
   void deleteSolver (SolverPtr S);
-  //If set, dump constraints to this file (as they are asserted in the solver)
+  //If set, dump constraints to this file (as they are asserted in the solver).
+  //Files named *.gnfb are written in the more compact binary GNF format, which readGNF also reads.
   void setOutputFile(SolverPtr S,char * output);
   void readGNF(SolverPtr S, const char  * filename);
 
@@ -98,6 +99,12 @@ typedef int64_t Weight;
   int solveLimited(SolverPtr S);
   //Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
   int solveAssumptionsLimited(SolverPtr S,int * assumptions, int n_assumptions);
+  //Solve with n_threads differently configured copies of the solver in parallel, keeping the first answer.
+  //The solver must have been created with '-portfolio=<n>' (which records its constraints, so that they can be copied);
+  //otherwise, this falls back on solveLimited. Solvers created with '-portfolio=<n>' also use n threads in every other solve call.
+  //Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
+  int solvePortfolio(SolverPtr S, int n_threads);
+  int solveAssumptionsPortfolio(SolverPtr S,int * assumptions, int n_assumptions, int n_threads);
 
   //Solve under assumptions, and also minimize a set of BVs (in order of precedence)
   //Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
@@ -139,6 +146,9 @@ typedef int64_t Weight;
   bool addUnitClause(SolverPtr S,int lit);
   bool addBinaryClause(SolverPtr S,int lit1, int lit2);
   bool addTertiaryClause(SolverPtr S,int lit1, int lit2, int lit3);
+  //Add n_clauses clauses at once. Clause i is lits[offsets[i]] ... lits[offsets[i+1]-1], so offsets has n_clauses+1 entries.
+  //Returns false if the solver became unsatisfiable (but still adds all of the clauses).
+  bool addClauses(SolverPtr S,int * lits, int * offsets, int n_clauses);
 
   //remove any optimization objectives from the solver
   void clearOptimizationObjectives(SolverPtr S);
@@ -155,6 +165,8 @@ typedef int64_t Weight;
   int newBitvector_const(SolverPtr S, BVTheoryPtr bv, int bvWidth, Weight constval);
   int newBitvector_anon(SolverPtr S, BVTheoryPtr bv, int bvWidth);
   int newBitvector(SolverPtr S, BVTheoryPtr bv, int * bits, int n_bits);
+  //Create n constant bitvectors of the same width at once, storing the ID of the bitvector for constvals[i] in out_bvIDs[i]
+  void newBitvectors_const(SolverPtr S, BVTheoryPtr bv, int bvWidth, Weight * constvals, int n, int * out_bvIDs);
   int bv_width(SolverPtr S, BVTheoryPtr  bv,int bvID);
   int newBVComparison_const_lt(SolverPtr S, BVTheoryPtr bv, int bvID, Weight weight);
   int newBVComparison_bv_lt(SolverPtr S, BVTheoryPtr bv, int bvID, int compareID);
@@ -203,6 +215,12 @@ typedef int64_t Weight;
   int newEdge(SolverPtr S, GraphTheorySolver_long G,int from,int  to,  Weight weight);
   int newEdge_double(SolverPtr S, GraphTheorySolver_double G,int from,int  to,  double weight);
   int newEdge_bv(SolverPtr S, GraphTheorySolver_long G,int from,int  to, int bvID);
+  //Batch versions of the above: add n nodes (numbered consecutively) and return the first of them
+  int newNodes(SolverPtr S,GraphTheorySolver_long G,int n);
+  //Add n edges, edge i from from[i] to to[i], storing its literal in out_lits[i]
+  void newEdges(SolverPtr S, GraphTheorySolver_long G,int * from,int * to,  Weight * weights, int n, int * out_lits);
+  void newEdges_double(SolverPtr S, GraphTheorySolver_double G,int * from,int * to,  double * weights, int n, int * out_lits);
+  void newEdges_bv(SolverPtr S, GraphTheorySolver_long G,int * from,int * to, int * bvIDs, int n, int * out_lits);
   int reaches(SolverPtr S,GraphTheorySolver_long G,int from, int to);
   int shortestPathUnweighted_lt_const(SolverPtr S,GraphTheorySolver_long G,int from, int to, int steps);
   int shortestPathUnweighted_leq_const(SolverPtr S,GraphTheorySolver_long G,int from, int to, int steps);
@@ -246,12 +264,22 @@ typedef int64_t Weight;
   //Get an assignment to a bitvector in the model. The model may find a range of satisfying assignments to the bitvector;
   //If getMaximumValue is true, this function returns the maximum satisfying assignment to the bitvector in the model; else it returns the smallest.
   Weight getModel_BV(SolverPtr S, BVTheoryPtr bv, int bvID, bool getMaximumValue);
+  //Batch versions of the above, storing the model value of lits[i] (or bvIDs[i]) in store[i]
+  void getModel_Literals(SolverPtr S,int * lits, int n_lits, int * store);
+  void getModel_BVs(SolverPtr S, BVTheoryPtr bv, int * bvIDs, int n_bvs, bool getMaximumValue, Weight * store);
   //graph queries:
   //maxflow_literal is the literal (not variable!) that is the atom for the maximum flow query
   Weight getModel_MaxFlow(SolverPtr S,GraphTheorySolver_long G,int maxflow_literal);
   //maxflow_literal is the literal (not variable!) that is the atom for the maximum flow query
   Weight getModel_EdgeFlow(SolverPtr S,GraphTheorySolver_long G,int maxflow_literal, int edgeLit);
   Weight getModel_AcyclicEdgeFlow(SolverPtr S,GraphTheorySolver_long G,int maxflow_literal, int edgeLit);
+  //Store the flow of every edge of G (indexed in the order the edges were created) in store.
+  //Returns the number of edges in G (without writing to store if store_length is less than that), or -1 if maxflow_literal is not a maximum flow literal.
+  int getModel_EdgeFlows(SolverPtr S,GraphTheorySolver_long G,int maxflow_literal, int store_length, Weight * store);
+  int getModel_AcyclicEdgeFlows(SolverPtr S,GraphTheorySolver_long G,int maxflow_literal, int store_length, Weight * store);
+  //Store a bitmap of the edges of G that are enabled in the model: edge i is enabled if bit (i%8) of store[i/8] is set.
+  //Returns the number of edges in G; store is only written to if it has room for all of them (store_length is in bytes).
+  int getModel_EnabledEdges(SolverPtr S,GraphTheorySolver_long G, int store_length, unsigned char * store);
 
   Weight getModel_MinimumSpanningTreeWeight(SolverPtr S,GraphTheorySolver_long G,int spanning_tree_literal);
   int getModel_Path_Nodes_Length(SolverPtr S,GraphTheorySolver_long G,int reach_or_distance_literal);
@@ -125,6 +125,10 @@ def _bv_Ite(i,t,e):
 #def Bv(width, const_value=None):
 #    return BVManager().Bv(width,const_value)                   
 
+#The model values of many bitvectors, read from the solver in one call
+def BVValues(bvs,getMaximumValue=False):
+    return BVManager()._monosat.getModel_BVs([bv.getID() for bv in bvs],getMaximumValue)
+
 def _checkBVs(bvs):
     for bv in bvs:
         assert(isinstance(bv,BitVector))
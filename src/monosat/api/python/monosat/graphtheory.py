@@ -20,6 +20,7 @@
 
 import monosat.monosat_c
 import sys
+import numbers
 from monosat.bvtheory import BitVector
 from monosat.logic import *
 from monosat.manager import Manager
@@ -131,12 +132,37 @@ class Graph():
 
         return n
     
+    #Add n nodes at once, returning the first of them (the new nodes are numbered consecutively)
+    def addNodes(self, n):
+        first = self._monosat.newNodes(self.graph,n)
+        self.nodes=first+n
+        for i in range(first,first+n):
+            self.out_edges.append([])
+            self.in_edges.append([])
+            self.names[i] = str(i)
+        return first
+
     def getSymbol(self,node):
         return self.names[node]
     
     def getMaxFlow(self, flowlit):
         return self._monosat.getModel_MaxFlow(self.graph,flowlit.getLit())
 
+    #Get the flow of every edge (in the same order as getAllEdges()) in one call. Must not be called before solve().
+    def getEdgeFlows(self, flowlit, force_acyclic_flow=False):
+        return self._monosat.getModel_EdgeFlows(self.graph,flowlit.getLit(),force_acyclic_flow)
+
+    """
+    Get the model value of every edge (in the same order as getAllEdges()) in one call.
+    Returns a list of Booleans, or if bitmap is True, a bytes object in which edge i is enabled if bit (i%8) of byte i//8 is set.
+    Must not be called before solve().
+    """
+    def getEnabledEdges(self, bitmap=False):
+        enabled = self._monosat.getModel_EnabledEdges(self.graph)
+        if bitmap:
+            return enabled
+        return [(enabled[i>>3]>>(i&7))&1==1 for i in range(self.numedges)]
+
     def getEdgeFlow(self, flowlit, edgelit,force_acyclic_flow=False):
         if force_acyclic_flow:            
             return self._monosat.getModel_AcyclicEdgeFlow(self.graph,flowlit.getLit(),edgelit.getLit())
@@ -220,6 +246,49 @@ class Graph():
         self.edgemap[e[2].getLit()] =e
         return e[2]
     
+    #Add an edge from froms[i] to tos[i] for each i, with weight weights[i] (or the same weight for every edge,
+    #if weights is a single number or bitvector), using one call into the solver.
+    #froms, tos and weights may be lists, or array.array or numpy arrays (which are passed to the solver without conversion).
+    #Returns the edge literals, in order.
+    def addEdges(self,froms,tos,weights=1):
+        n = len(froms)
+        assert(len(tos)==n)
+        if n==0:
+            return []
+        max_node = max(max(froms),max(tos))
+        if max_node>=self.numNodes():
+            self.addNodes(max_node+1-self.numNodes())
+        if weights is None or isinstance(weights,(numbers.Number,BitVector)):
+            weights = [weights]*n
+        assert(len(weights)==n)
+
+        if n and isinstance(weights[0], BitVector):
+            assert(self.graph_type==Graph.GraphType.int)
+            self.has_any_bv_edges=True
+            assert(not self.has_any_non_bv_edges)
+            lits = self._monosat.newEdges_bv(self.graph,froms,tos,[w.getID() for w in weights])
+        else:
+            self.has_any_non_bv_edges=True
+            assert(not self.has_any_bv_edges)
+            if self.graph_type==Graph.GraphType.int:
+                lits = self._monosat.newEdges(self.graph,froms,tos,weights)
+            elif self.graph_type==Graph.GraphType.float:
+                lits = self._monosat.newEdges_double(self.graph,froms,tos,weights)
+
+        #array.array and numpy arrays convert to lists of python ints much faster than they can be indexed
+        froms = froms.tolist() if hasattr(froms,'tolist') else froms
+        tos = tos.tolist() if hasattr(tos,'tolist') else tos
+        weights = weights.tolist() if hasattr(weights,'tolist') else weights
+        edge_vars = [Var(l) for l in lits]
+        new_edges = list(zip(froms,tos,edge_vars,weights))
+        for e in new_edges:
+            self.out_edges[e[0]].append(e)
+            self.in_edges[e[1]].append(e)
+        self.alledges.extend(new_edges)
+        self.edgemap.update(zip(lits,new_edges))
+        self.numedges=self.numedges+n
+        return edge_vars
+
     def addUndirectedEdge(self,v,w, weight=1):
         while(v>=self.numNodes() or w>=self.numNodes()):
             self.addNode()
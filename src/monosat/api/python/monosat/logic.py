@@ -524,6 +524,17 @@ def AssertClause(clause):
     _addClause(clause)
     #_monosat.addClause([a.getLit() for a in clause])
 
+#Add many clauses with a single call into the solver
+def AssertClauses(clauses):
+    lits = []
+    offsets = [0]
+    for clause in clauses:
+        clause = [VAR(x) for x in clause]
+        _checkLits(clause)
+        lits.extend(x.getLit() for x in clause)
+        offsets.append(len(lits))
+    _monosat.addClauses(lits,offsets)
+
 def Assert(a):
     
     if(a is False or a is True):
@@ -773,6 +784,12 @@ def _LessOrEqual(num1, num2):
     
     return lt, Or(lt, Not(gt))
 
+#The model values of many variables (True, False, or None if unassigned), read from the solver in one call
+def Values(vars):
+    vals = _monosat.getModel_Literals([v.lit if isinstance(v,Var) else VAR(v).getLit() for v in vars])
+    return [_model_values[v] for v in vals]
+_model_values = (True,False,None)
+
 def isTrue(v):
     return VAR(v).isConstTrue()
 
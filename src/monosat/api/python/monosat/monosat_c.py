@@ -131,6 +131,7 @@ class Monosat(metaclass=Singleton):
         self.monosat_c.deleteSolver.argtypes=[c_solver_p]
         
         self.monosat_c.readGNF.argtypes=[c_solver_p, c_char_p]
+        self.monosat_c.setOutputFile.argtypes=[c_solver_p, c_char_p]
         
         self.monosat_c.solve.argtypes=[c_solver_p]
         self.monosat_c.solve.restype=c_bool
@@ -145,6 +146,9 @@ class Monosat(metaclass=Singleton):
         self.monosat_c.solveAssumptionsLimited.argtypes=[c_solver_p,c_literal_p,c_int]
         self.monosat_c.solveAssumptionsLimited.restype=c_int      
 
+        self.monosat_c.solveAssumptionsPortfolio.argtypes=[c_solver_p,c_literal_p,c_int,c_int]
+        self.monosat_c.solveAssumptionsPortfolio.restype=c_int
+
 
         
         
@@ -191,6 +195,9 @@ class Monosat(metaclass=Singleton):
 
         self.monosat_c.addTertiaryClause.argtypes=[c_solver_p,c_literal,c_literal,c_literal]
         self.monosat_c.addTertiaryClause.restype=c_bool
+
+        self.monosat_c.addClauses.argtypes=[c_solver_p,c_literal_p,c_int_p,c_int]
+        self.monosat_c.addClauses.restype=c_bool
         
         self.monosat_c.true_lit.argtypes=[c_solver_p]
         self.monosat_c.true_lit.restype=c_int
@@ -220,6 +227,8 @@ class Monosat(metaclass=Singleton):
         
         self.monosat_c.newBitvector_const.argtypes=[c_solver_p,c_bv_p, c_int, c_long]
         self.monosat_c.newBitvector_const.restype=c_bvID
+
+        self.monosat_c.newBitvectors_const.argtypes=[c_solver_p,c_bv_p, c_int, c_long_p, c_int, c_int_p]
         
         self.monosat_c.newBitvector.argtypes=[c_solver_p,c_bv_p, c_var_p, c_int]
         self.monosat_c.newBitvector.restype=c_bvID
@@ -288,6 +297,15 @@ class Monosat(metaclass=Singleton):
        
         self.monosat_c.newEdge_bv.argtypes=[c_solver_p,c_graph_p, c_int, c_int, c_bvID]
         self.monosat_c.newEdge_bv.restype=c_literal
+
+        self.monosat_c.newNodes.argtypes=[c_solver_p,c_graph_p,c_int]
+        self.monosat_c.newNodes.restype=c_int
+
+        self.monosat_c.newEdges.argtypes=[c_solver_p,c_graph_p, c_int_p, c_int_p, c_long_p, c_int, c_literal_p]
+
+        self.monosat_c.newEdges_double.argtypes=[c_solver_p,c_graph_p, c_int_p, c_int_p, POINTER(c_double), c_int, c_literal_p]
+
+        self.monosat_c.newEdges_bv.argtypes=[c_solver_p,c_graph_p, c_int_p, c_int_p, c_int_p, c_int, c_literal_p]
        
         self.monosat_c.reaches.argtypes=[c_solver_p,c_graph_p, c_int, c_int]
         self.monosat_c.reaches.restype=c_literal
@@ -368,6 +386,19 @@ class Monosat(metaclass=Singleton):
         self.monosat_c.getModel_Literal.argtypes=[c_solver_p,c_literal]
         self.monosat_c.getModel_Literal.restype=c_int      
 
+        self.monosat_c.getModel_Literals.argtypes=[c_solver_p,c_literal_p,c_int,c_int_p]
+
+        self.monosat_c.getModel_BVs.argtypes=[c_solver_p,c_bv_p,c_int_p,c_int,c_bool,c_long_p]
+
+        self.monosat_c.getModel_EdgeFlows.argtypes=[c_solver_p,c_graph_p, c_literal, c_int, c_long_p]
+        self.monosat_c.getModel_EdgeFlows.restype=c_int
+
+        self.monosat_c.getModel_AcyclicEdgeFlows.argtypes=[c_solver_p,c_graph_p, c_literal, c_int, c_long_p]
+        self.monosat_c.getModel_AcyclicEdgeFlows.restype=c_int
+
+        self.monosat_c.getModel_EnabledEdges.argtypes=[c_solver_p,c_graph_p, c_int, c_char_p]
+        self.monosat_c.getModel_EnabledEdges.restype=c_int
+
         self.monosat_c.getModel_BV.argtypes=[c_solver_p,c_bv_p, c_bvID, c_bool]
         self.monosat_c.getModel_BV.restype=c_long    
 
@@ -460,6 +491,7 @@ class Monosat(metaclass=Singleton):
         return self.solver.output
     
     def setOutputFile(self, filename):
+        #Files named *.gnfb are written as binary GNF, which is smaller and faster to load with readGNF
         self.monosat_c.setOutputFile(self.solver._ptr,c_char_p(filename.encode('ascii')))
         # self.solver.output=file
         # if file is not None:#Otherwise, this unit clause will have been skipped in the output file
@@ -503,6 +535,19 @@ class Monosat(metaclass=Singleton):
             self._long_array[i]=c_long(n)
         return self._long_array
 
+    def getBuffer(self,values,ctype):
+        #array.array and numpy arrays whose elements already have the C type are passed through without copying;
+        #anything else is copied into a new ctypes array.
+        try:
+            view = memoryview(values)
+        except TypeError:
+            view = None
+        if view is not None and view.ndim==1 and view.c_contiguous and not view.readonly and view.itemsize==sizeof(ctype):
+            fmt = view.format.lstrip('@=')
+            if fmt==ctype._type_ or (ctype in (c_int,c_long) and fmt in ('i','l','q')):
+                return (ctype * len(view)).from_buffer(values)
+        return (ctype * len(values))(*values)
+
     def intArrayToList(self, array_pointer,length):
         ret = []
         for i in range(length):
@@ -581,6 +626,28 @@ class Monosat(metaclass=Singleton):
         else:
             assert(r==2)
             return None  
+
+    #Solve using n_threads differently configured solvers in parallel (see solvePortfolio() in Monosat.h).
+    #The solver must have been created with the argument '-portfolio=<n>'; otherwise this solves with a single thread.
+    def solvePortfolio(self,n_threads,assumptions=None):
+        self.backtrack()
+        if assumptions is None:
+            assumptions=[]
+
+        lp = self.getIntArray(assumptions)
+
+        if self.solver.output:
+            self._echoOutput("solve " + " ".join((str(dimacs(c)) for c in assumptions))+"\n")
+            self.solver.output.flush()
+        r= self.monosat_c.solveAssumptionsPortfolio(self.solver._ptr,lp,len(assumptions),n_threads)
+
+        if r==0:
+            return True
+        elif r==1:
+            return False
+        else:
+            assert(r==2)
+            return None
     
     def backtrack(self):
         if self.solver.output:
@@ -630,6 +697,16 @@ class Monosat(metaclass=Singleton):
             lp = self.getIntArray(clause)
             self.monosat_c.addClause(self.solver._ptr,lp,len(clause))
 
+    def addClauses(self,lits,offsets):
+        #Add many clauses in one call: clause i is lits[offsets[i]:offsets[i+1]] (so offsets has one more entry than there are clauses)
+        self.backtrack()
+        lp = self.getBuffer(lits,c_int)
+        op = self.getBuffer(offsets,c_int)
+        if self.solver.output:
+            for i in range(len(op)-1):
+                self._echoOutput(" ".join((str(dimacs(lp[j])) for j in range(op[i],op[i+1])))+" 0\n")
+        return self.monosat_c.addClauses(self.solver._ptr,lp,op,len(op)-1)
+
     def clearOptimizationObjectives(self):
         if self.solver.output:
             self._echoOutput("clear_opt\n")
@@ -806,6 +883,17 @@ class Monosat(metaclass=Singleton):
         if self.solver.output:
             self._echoOutput("bv const %d %d "%(bvID, width) + str((val)) +"\n" )   
         return bvID
+
+    #Create a constant bitvector of the given width for each value, in one call
+    def newBitvectors_const(self, width,vals):
+        self.backtrack()
+        n = len(vals)
+        bvIDs = (c_int * n)()
+        self.monosat_c.newBitvectors_const(self.solver._ptr,self.solver.bvtheory, width, self.getBuffer(vals,c_long),n,bvIDs)
+        if self.solver.output:
+            for i in range(n):
+                self._echoOutput("bv const %d %d "%(bvIDs[i], width) + str((vals[i])) +"\n" )
+        return bvIDs[:]
     
     
     def nBitvectors(self):
@@ -1114,6 +1202,44 @@ class Monosat(metaclass=Singleton):
         return l
 
     
+    def newNodes(self, graph, n):
+        self.backtrack()
+        return self.monosat_c.newNodes(self.solver._ptr,graph,c_int(n))
+
+    #Add len(froms) edges in one call, returning their literals
+    def newEdges(self, graph, froms,tos, weights):
+        self.backtrack()
+        n = len(froms)
+        assert(len(tos)==n and len(weights)==n)
+        lits = (c_int * n)()
+        self.monosat_c.newEdges(self.solver._ptr,graph,self.getBuffer(froms,c_int),self.getBuffer(tos,c_int),self.getBuffer(weights,c_long),n,lits)
+        if self.solver.output:
+            for i in range(n):
+                self._echoOutput("edge " + str(self.getGID(graph)) + " " + str(froms[i]) + " " + str(tos[i]) + " " +  str(dimacs(lits[i])) + " " + str((weights[i]))  + "\n")
+        return lits[:]
+
+    def newEdges_double(self, graph, froms,tos, weights):
+        self.backtrack()
+        n = len(froms)
+        assert(len(tos)==n and len(weights)==n)
+        lits = (c_int * n)()
+        self.monosat_c.newEdges_double(self.solver._ptr,graph,self.getBuffer(froms,c_int),self.getBuffer(tos,c_int),self.getBuffer(weights,c_double),n,lits)
+        if self.solver.output:
+            for i in range(n):
+                self._echoOutput("edge " + str(self.getGID(graph)) + " " + str(froms[i]) + " " + str(tos[i]) + " " +  str(dimacs(lits[i])) + " " + str((weights[i]))  + "\n")
+        return lits[:]
+
+    def newEdges_bv(self, graph, froms,tos, bvIDs):
+        self.backtrack()
+        n = len(froms)
+        assert(len(tos)==n and len(bvIDs)==n)
+        lits = (c_int * n)()
+        self.monosat_c.newEdges_bv(self.solver._ptr,graph,self.getBuffer(froms,c_int),self.getBuffer(tos,c_int),self.getBuffer(bvIDs,c_int),n,lits)
+        if self.solver.output:
+            for i in range(n):
+                self._echoOutput("edge_bv " + str(self.getGID(graph)) + " " + str(froms[i]) + " " + str(tos[i]) + " " +  str(dimacs(lits[i])) + " " + str((bvIDs[i]))  + "\n")
+        return lits[:]
+
     def reaches(self, graph, u,v):
         self.backtrack()
         l= self.monosat_c.reaches(self.solver._ptr,graph,c_int(u),c_int(v))
@@ -1226,6 +1352,19 @@ class Monosat(metaclass=Singleton):
     def getModel_BV(self, bvID,getMaximumValue=False):
         return self.monosat_c.getModel_BV(self.solver._ptr, self.solver.bvtheory,c_bvID(bvID),c_bool(getMaximumValue));
         
+    #Batch versions of getModel_Literal and getModel_BV, returning the model values in a list, in the same order as their arguments
+    def getModel_Literals(self, lits):
+        n = len(lits)
+        store = (c_int * n)()
+        self.monosat_c.getModel_Literals(self.solver._ptr, self.getBuffer(lits,c_int),n,store)
+        return store[:]
+
+    def getModel_BVs(self, bvIDs,getMaximumValue=False):
+        n = len(bvIDs)
+        store = (c_long * n)()
+        self.monosat_c.getModel_BVs(self.solver._ptr, self.solver.bvtheory,self.getBuffer(bvIDs,c_int),n,c_bool(getMaximumValue),store)
+        return store[:]
+
     def getModel_MaxFlow(self, graph, flowlit):
         return self.monosat_c.getModel_MaxFlow(self.solver._ptr, graph,flowlit);
         
@@ -1236,6 +1375,25 @@ class Monosat(metaclass=Singleton):
         return self.monosat_c.getModel_AcyclicEdgeFlow(self.solver._ptr, graph,flowlit, edgelit);
 
 
+    #Returns the flow of every edge of the graph (in the order the edges were created), or None if flowlit is not a maximum flow literal
+    def getModel_EdgeFlows(self, graph, flowlit, acyclic=False):
+        get = self.monosat_c.getModel_AcyclicEdgeFlows if acyclic else self.monosat_c.getModel_EdgeFlows
+        n = get(self.solver._ptr, graph,flowlit,0,None)
+        if n<0:
+            return None
+        store = (c_long * n)()
+        if get(self.solver._ptr, graph,flowlit,n,store)!=n:
+            raise RuntimeError("Error reading edge flows")
+        return store[:]
+
+    #Returns a bitmap (as bytes) of the edges of the graph that are enabled in the model: edge i is enabled if bit (i%8) of byte i//8 is set
+    def getModel_EnabledEdges(self, graph):
+        n = self.monosat_c.getModel_EnabledEdges(self.solver._ptr, graph,0,None)
+        store = create_string_buffer((n+7)//8)
+        if self.monosat_c.getModel_EnabledEdges(self.solver._ptr, graph,len(store),store)!=n:
+            raise RuntimeError("Error reading enabled edges")
+        return store.raw
+
     def getModel_MinimumSpanningTreeWeight(self, graph, mstlit):
         return self.monosat_c.getModel_MinimumSpanningTreeWeight(self.solver._ptr, graph,mstlit); 
 
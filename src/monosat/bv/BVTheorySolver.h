@@ -28,6 +28,7 @@
 
 #include "monosat/core/SolverTypes.h"
 #include "monosat/mtl/Map.h"
+#include "monosat/mtl/Sort.h"
 
 #include "monosat/bv/BVTheory.h"
 #include "monosat/utils/System.h"
@@ -447,7 +448,7 @@ public:
 			Weight overApprox = over_approx[bvID];
 
 
-			assert(under_approx>=0); assert(overApprox>=0);
+			assert(underApprox>=0); assert(overApprox>=0);
 			vec<Lit> & bv = theory.bitvectors[bvID];
 
 			int bitpos=-1;
@@ -630,6 +631,7 @@ public:
 			}
 			void backtrack(Assignment & e, bool rewind)override{
 				if(!rewind){
+					theory.unpropagateComparison(getID());
 					if (theory.comparison_needs_repropagation[getID()]){
 						if(!theory.alteredBV[bvID]){
 							theory.alteredBV[bvID]=true;
@@ -3637,6 +3639,7 @@ public:
 
 private:
 	TheorySolver * S;
+	const SolverConfig & config;
 
 	bool comp(Comparison op, Weight o1, Weight o2){
 		switch (op){
@@ -3687,12 +3690,24 @@ public:
 
 	vec<vec<int> > cause_set;//for each bv, this is the set of all bitvectors that have a greater id and might need to have their approx updated when this bv's approx changes.
 	vec<vec<int> > compares; //for each bitvector, comparisons are all to unique values, and in ascending order of compareTo.
+	//for each bitvector, the number of comparisons at the start (resp. end) of compares[bvID] that have been propagated
+	//from the under (resp. over) approximation, and whose literals are still assigned.
+	vec<int> compare_under_pos;
+	vec<int> compare_over_pos;
 	vec<vec<int>> bvcompares;
 	vec<int> eq_bitvectors;//if a bv has been proven to be equivalent to another, lower index bv, put the lowest such index here.
 	vec<bool> bv_needs_propagation;
 	vec<bool> comparison_needs_repropagation;
 	vec<int> repropagate_comparisons;
 
+	struct ComparisonWeightLt{
+		BVTheorySolver & theory;
+		ComparisonWeightLt(BVTheorySolver & theory):theory(theory){}
+		bool operator()(int cID1, int cID2)const{
+			return ((ComparisonOp &) theory.getOperation(cID1)).w < ((ComparisonOp &) theory.getOperation(cID2)).w;
+		}
+	};
+
 
 
 
@@ -3813,7 +3828,7 @@ public:
 	long statis_bv_updates = 0;
 
 	BVTheorySolver(TheorySolver * S ) :
-			S(S){
+			S(S), config(S->getConfig()){
 		rnd_seed = drand(S->getRandomSeed());
 		S->addTheory(this);
 		S->setBVTheory(this);
@@ -3932,6 +3947,10 @@ public:
 			op.move(bvID2);
 			compares[bvID2].push(cID);
 		}
+		//restore the order of bvID2's comparisons, and propagate them all again
+		sort(compares[bvID2],ComparisonWeightLt(*this));
+		compare_under_pos[bvID2]=0;
+		compare_over_pos[bvID2]=0;
 
 		for(int i = bvcompares[bvID1].size()-1;i>=0;i--){
 			int cID = bvcompares[bvID1][i];
@@ -4616,10 +4635,6 @@ public:
 	;
 
 	void buildReason(Lit p, vec<Lit> & reason,CRef marker) {
-		static int iter = 0;
-		if(++iter==39){//17
-			int a =1;
-		}
 		assert(value(p)!=l_False);
 
 		assert(marker != CRef_Undef);
@@ -4838,8 +4853,6 @@ public:
 		}
 		double update_start_time= rtime(3);
 		statis_bv_updates++;
-		static int iter = 0;
-		++iter;
 
 #ifndef NDEBUG
 /*		for(int i = 0;i<vars.size();i++){
@@ -5047,7 +5060,6 @@ public:
 
 	void writeBounds(int bvID){
 		if(opt_write_learnt_clauses && opt_write_bv_bounds){
-			static int bound_num=0;
 			if(++opt_n_learnts==44231){
 				int a=1;
 			}
@@ -5072,10 +5084,6 @@ public:
 				}
 			}
 			fprintf(opt_write_learnt_clauses," 0\n");
-			++bound_num;
-			if(bound_num==10){
-				int a=1;
-			}
 
 			if(++opt_n_learnts==44231){
 				int a=1;
@@ -5097,10 +5105,6 @@ public:
 				}
 			}
 			fprintf(opt_write_learnt_clauses," 0\n");
-			if(++bound_num==10){
-				int  a=1;
-			}
-			//fprintf(opt_write_learnt_clauses,"%d\n", bound_num);
 			fflush(opt_write_learnt_clauses);
 		}
 	}
@@ -5281,8 +5285,74 @@ public:
 	bool propagateTheory(vec<Lit> & conflict){
 		return propagateTheory(conflict,false);
 	}
+
+	//Comparisons to constants are kept in ascending order of their constant, so the comparisons implied by the over approximation
+	//of a bitvector are a suffix of compares[bvID], and those implied by its under approximation are a prefix.
+	//Only the comparisons between the propagated positions and the current approximations are visited, so the cost of
+	//propagation is proportional to the number of thresholds crossed, rather than to the number of comparisons.
+	bool propagateComparisons(int bvID, bool & changed, vec<Lit> & conflict){
+		vec<int> & compare = compares[bvID];
+		assert(dbg_compares_sorted(bvID));
+		const Weight & underApprox = under_approx[bvID];
+		const Weight & overApprox = over_approx[bvID];
+
+		int & over_pos = compare_over_pos[bvID];
+		assert(over_pos>=0);assert(over_pos<=compare.size());
+		for(;over_pos<compare.size();over_pos++){
+			int cID = compare[compare.size()-1-over_pos];
+			assert( getOperation(cID).getType()==OperationType::cause_is_comparison);
+			ComparisonOp & c = (ComparisonOp &) getOperation(cID);
+			if(c.w<=overApprox)
+				break;
+			if(!c.propagate(changed,conflict,true))
+				return false;
+		}
+		//whether a comparison to exactly the over approximation is implied depends on its operator, so these are always checked
+		for(int i=compare.size()-1-over_pos;i>=0;i--){
+			ComparisonOp & c = (ComparisonOp &) getOperation(compare[i]);
+			if(c.w!=overApprox)
+				break;
+			if(!c.propagate(changed,conflict,true))
+				return false;
+		}
+
+		int & under_pos = compare_under_pos[bvID];
+		assert(under_pos>=0);assert(under_pos<=compare.size());
+		for(;under_pos<compare.size();under_pos++){
+			int cID = compare[under_pos];
+			assert( getOperation(cID).getType()==OperationType::cause_is_comparison);
+			ComparisonOp & c = (ComparisonOp &) getOperation(cID);
+			if(c.w>=underApprox)
+				break;
+			if(!c.propagate(changed,conflict,false))
+				return false;
+		}
+		for(int i=under_pos;i<compare.size();i++){
+			ComparisonOp & c = (ComparisonOp &) getOperation(compare[i]);
+			if(c.w!=underApprox)
+				break;
+			if(!c.propagate(changed,conflict,false))
+				return false;
+		}
+		return true;
+	}
+
+	//Called when the literal of a comparison to a constant is unassigned, so that it will be propagated again the next
+	//time that it is crossed by the under or over approximation of its bitvector.
+	void unpropagateComparison(int cID){
+		ComparisonOp & c = (ComparisonOp &) getOperation(cID);
+		int bvID = c.getBV();
+		vec<int> & compare = compares[bvID];
+		int pos = binary_search_Weight(compare,c.w);
+		assert(pos>=0);assert(((ComparisonOp &) getOperation(compare[pos])).w==c.w);
+		if(compare_under_pos[bvID]>pos)
+			compare_under_pos[bvID]=pos;
+		while(pos+1<compare.size() && ((ComparisonOp &) getOperation(compare[pos+1])).w==c.w)
+			pos++;
+		if(compare_over_pos[bvID]>compare.size()-1-pos)
+			compare_over_pos[bvID]=compare.size()-1-pos;
+	}
 	bool propagateTheory(vec<Lit> & conflict, bool force_propagation) {
-		static int realprops = 0;
 		stats_propagations++;
 		if(stats_propagations==55){
 			int a=1;
@@ -5295,15 +5365,12 @@ public:
 
 		propagations++;
 
-		if (!force_propagation && (propagations % opt_bv_prop_skip != 0)){
+		if (!force_propagation && (propagations % config.bv_prop_skip != 0)){
 			stats_propagations_skipped++;
 			return true;
 		}
 
 		rewind_trail_pos(trail.size());
-		if(++realprops==14){
-			int a =1;
-		}
 		//printf("bv prop %d\n",stats_propagations);
 		if(stats_propagations==22){
 			int a =1;
@@ -5367,27 +5434,8 @@ public:
 				}
 			}
 
-			vec<int> & compare = compares[bvID];
-			//update over approx lits.
-			//It might be worth doing a binary search here...
-			for(int i = 0;i<compare.size();i++){
-				int cID = compare[i];
-
-				assert( getOperation(cID).getType()==OperationType::cause_is_comparison);
-				ComparisonOp & c = (ComparisonOp &) getOperation(cID);
-
-				if(!c.propagate(changed,conflict,true))
-					return false;
-			}
-
-			for(int i=compare.size()-1;i>=0;i--){
-				int cID = compare[i];
-				assert( getOperation(cID).getType()==OperationType::cause_is_comparison);
-				ComparisonOp & c = (ComparisonOp &) getOperation(cID);
-
-				if(!c.propagate(changed,conflict,false))
-					return false;
-			}
+			if(!propagateComparisons(bvID,changed,conflict))
+				return false;
 
 			//comparisons to bitvectors.
 			/*vec<int> & bvcompare = bvcompares[bvID];
@@ -5558,12 +5606,7 @@ public:
 			bvID=eq_bitvectors[bvID];
 		writeBounds(bvID);
 		stats_build_value_reason++;
-		static int iter = 0;
-		++iter;
 		//printf("reason %d: %d\n",iter,bvID);
-		if(iter==430){
-			int a=1;
-		}
 
 		//rewind_trail_pos(trail_pos);
 		//trail_pos  = rewindUntil(bvID,op,to);
@@ -5607,10 +5650,6 @@ public:
 			return;
 		}
 		if(opt_write_learnt_clauses && opt_write_bv_analysis){
-			static int n_analysis=0;
-			if(++n_analysis==430){
-				int a =1;
-			}
 			std::stringstream ss;
 			ss<< op << " " << to;
 			fprintf(opt_write_learnt_clauses,"learnt analysis bv %d %s ",unmapBV( bvID),ss.str().c_str());
@@ -5880,7 +5919,6 @@ public:
 	}
 
 	void analyze(vec<Lit> & conflict){
-		static long iter = 0;
 		int prev_pos = analysis_trail_pos;
 		while(n_pending_analyses>0){
 
@@ -6233,6 +6271,8 @@ public:
 		alteredBV.growTo(bvID+1);
 		bvcompares.growTo(bvID+1);
 		compares.growTo(bvID+1);
+		compare_under_pos.growTo(bvID+1);
+		compare_over_pos.growTo(bvID+1);
 		bvconst.growTo(bvID+1);
 		operation_ids.growTo(bvID+1);
 
@@ -6482,6 +6522,8 @@ public:
 		alteredBV.growTo(bvID+1);
 		bvcompares.growTo(bvID+1);
 		compares.growTo(bvID+1);
+		compare_under_pos.growTo(bvID+1);
+		compare_over_pos.growTo(bvID+1);
 		operation_ids.growTo(bvID+1);
 		under_causes.growTo(bvID+1);
 		over_causes.growTo(bvID+1);
@@ -6546,6 +6588,8 @@ public:
 		alteredBV.growTo(bvID+1);
 		bvcompares.growTo(bvID+1);
 		compares.growTo(bvID+1);
+		compare_under_pos.growTo(bvID+1);
+		compare_over_pos.growTo(bvID+1);
 		operation_ids.growTo(bvID+1);
 		under_causes.growTo(bvID+1);
 		over_causes.growTo(bvID+1);
@@ -6830,10 +6874,6 @@ public:
 			l = mkLit(newVar(outerVar, comparisonID,true,decidable));
 
 		}
-		static int iter = 0;
-		if(++iter==29){
-			int a =1;
-		}
 
 		if(opt_write_learnt_clauses){
 			std::stringstream ss;
@@ -6864,6 +6904,11 @@ public:
 			}
 			compare[insertPos]=comparisonID;
 		}
+		//the new comparison has not been propagated yet
+		if(compare_under_pos[bvID]>insertPos)
+			compare_under_pos[bvID]=insertPos;
+		if(compare_over_pos[bvID]>compare.size()-1-insertPos)
+			compare_over_pos[bvID]=compare.size()-1-insertPos;
 
 		dbg_compares_sorted(bvID);
 
@@ -7605,7 +7650,7 @@ template<typename Weight>
 Weight BVTheorySolver<Weight>::refine_ubound_check(int bvID, Weight bound, Var ignore_bit){
 #ifndef NDEBUG
 	//test all values of mbits, find the lowest one >= i
-	static vec<Weight> vals;
+	static thread_local vec<Weight> vals;
 	vals.clear();
 
     dbg_evaluate(bvID,bitvectors[bvID].size()-1,vals,0);
@@ -7625,7 +7670,7 @@ template<typename Weight>
 Weight BVTheorySolver<Weight>::refine_lbound_check(int bvID, Weight bound, Var ignore_bit){
 #ifndef NDEBUG
 	//test all values of mbits, find the lowest one >= i
-	static vec<Weight> vals;
+	static thread_local vec<Weight> vals;
 	vals.clear();
 
     dbg_evaluate(bvID,bitvectors[bvID].size()-1,vals,0);
@@ -0,0 +1,351 @@
+/****************************************************************************************[BinaryGNF.cpp]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/BinaryGNF.h"
+#include <climits>
+#include <cstring>
+#include <unordered_map>
+
+using namespace Monosat;
+
+//The keywords of version 1 of the format. Only append to this list (and increment BinaryGNF::version)!
+static const char * const keywords[] = {
+		//core
+		"solve", "clear_opt", "minimize bv", "maximize bv", "minimize lits", "maximize lits", "amo",
+		//graphs
+		"digraph", "edge", "edge_bv", "weighted_edge", "edge_priority", "reach", "distance_lt", "distance_leq",
+		"weighted_distance_lt", "weighted_distance_leq", "weighted_distance_bv_lt", "weighted_distance_bv_leq",
+		"maximum_flow_geq", "maximum_flow_gt", "maximum_flow_bv_geq", "maximum_flow_bv_gt", "max_flow_gt",
+		"mst_weight_leq", "mst_weight_lt", "mst_edge", "forest", "acyclic", "connected_component_count_lt",
+		//bitvectors
+		"bv", "bv anon", "bv const", "bv <", "bv <=", "bv >", "bv >=", "bv const <", "bv const <=", "bv const >",
+		"bv const >=", "bv +", "bv -", "bv ite", "bv_ite", "bv min", "bv max", "bv popcount", "bv not", "bv and",
+		"bv nand", "bv or", "bv nor", "bv xor", "bv xnor", "bv concat", "bv slice",
+		//pseudo-boolean constraints
+		"pb <", "pb <=", "pb =", "pb ==", "pb >=", "pb >",
+		//finite state machines
+		"fsm", "transition", "str", "accepts", "accepts_composition", "generates", "transduces" };
+static const int n_keywords = sizeof(keywords) / sizeof(keywords[0]);
+
+static int findKeyword(const std::string & keyword) {
+	static const std::unordered_map<std::string, int> ids = []() {
+		std::unordered_map<std::string, int> ids;
+		for (int i = 0; i < n_keywords; i++)
+			ids[keywords[i]] = i;
+		return ids;
+	}();
+	auto it = ids.find(keyword);
+	return it == ids.end() ? -1 : it->second;
+}
+
+static inline bool isBlank(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+//Parse [begin,end) as a decimal integer (with an optional sign), as parseLong() would.
+static bool parseInteger(const char * begin, const char * end, int64_t & value) {
+	bool neg = false;
+	if (begin < end && (*begin == '-' || *begin == '+')) {
+		neg = *begin == '-';
+		begin++;
+	}
+	//(rejecting anything that might overflow)
+	if (begin == end || end - begin > 18)
+		return false;
+	value = 0;
+	for (const char * p = begin; p < end; p++) {
+		if (*p < '0' || *p > '9')
+			return false;
+		value = value * 10 + (*p - '0');
+	}
+	if (neg)
+		value = -value;
+	return true;
+}
+
+BinaryGNFWriter::BinaryGNFWriter(FILE * out) :
+		out(out) {
+	for (unsigned char c : BinaryGNF::magic)
+		buf.push_back(c);
+	writeVarint(BinaryGNF::version);
+}
+
+BinaryGNFWriter::~BinaryGNFWriter() {
+	if (partial_line.size())
+		encodeLine(partial_line.data(), partial_line.data() + partial_line.size());
+	flush();
+	fclose(out);
+}
+
+bool BinaryGNFWriter::flush() {
+	if (buf.size()) {
+		if (fwrite(buf.data(), 1, buf.size(), out) != buf.size())
+			ok = false;
+		buf.clear();
+	}
+	if (fflush(out) != 0)
+		ok = false;
+	return ok;
+}
+
+bool BinaryGNFWriter::write(const char * text, size_t length) {
+	const char * end = text + length;
+	while (text < end) {
+		const char * newline = (const char *) memchr(text, '\n', end - text);
+		if (!newline) {
+			partial_line.append(text, end);
+			break;
+		}
+		if (partial_line.size()) {
+			partial_line.append(text, newline);
+			encodeLine(partial_line.data(), partial_line.data() + partial_line.size());
+			partial_line.clear();
+		} else {
+			encodeLine(text, newline);
+		}
+		text = newline + 1;
+	}
+	if (buf.size() >= buffer_size)
+		flush();
+	return ok;
+}
+
+static inline int64_t dimacsLit(Lit l) {
+	return dimacs(l);
+}
+static inline int64_t dimacsLit(int64_t l) {
+	return l;
+}
+
+template<class L>
+void BinaryGNFWriter::writeClauseLits(const L * lits, size_t n) {
+	writeVarint((uint64_t) n << 1);
+	int64_t prev_var = clause_var;
+	for (size_t i = 0; i < n; i++) {
+		int64_t lit = dimacsLit(lits[i]);
+		int64_t var = lit < 0 ? -lit : lit;
+		writeVarint((zigzag(var - prev_var) << 1) | (lit < 0));
+		prev_var = var;
+		if (i == 0)
+			clause_var = var;
+	}
+}
+
+bool BinaryGNFWriter::writeClause(const vec<Lit> & clause) {
+	writeClauseLits(clause.begin(), clause.size());
+	if (buf.size() >= buffer_size)
+		flush();
+	return ok;
+}
+
+void BinaryGNFWriter::writeText(const char * begin, const char * end) {
+	writeVarint(1);
+	writeVarint(end - begin);
+	size_t start = buf.size();
+	buf.resize(start + (end - begin));
+	memcpy(buf.data() + start, begin, end - begin);
+}
+
+/**
+ * Encode one line of text GNF (without its newline).
+ * Lines made up only of integers are clauses (possibly several on the same line); other lines are split into
+ * a keyword (the words up to the first integer) and integer arguments. Anything that doesn't fit either of these,
+ * or that has an unknown keyword, is stored as text.
+ */
+void BinaryGNFWriter::encodeLine(const char * begin, const char * end) {
+	keyword.clear();
+	args.clear();
+	const char * p = begin;
+	while (p < end) {
+		while (p < end && isBlank(*p))
+			p++;
+		if (p == end)
+			break;
+		const char * token = p;
+		while (p < end && !isBlank(*p))
+			p++;
+		int64_t value;
+		if (parseInteger(token, p, value)) {
+			args.push_back(value);
+		} else if (args.empty()) {
+			if (keyword.size())
+				keyword.push_back(' ');
+			keyword.append(token, p);
+		} else {
+			//a word after the arguments
+			writeText(begin, end);
+			return;
+		}
+	}
+	if (keyword.empty()) {
+		if (args.empty())
+			return; //blank line
+		//clauses
+		if (args.back() != 0) {
+			//this clause continues on the next line
+			writeText(begin, end);
+			return;
+		}
+		for (int64_t arg : args) {
+			if (arg > INT_MAX || arg < -INT_MAX) {
+				writeText(begin, end);
+				return;
+			}
+		}
+		size_t clause_start = 0;
+		for (size_t i = 0; i < args.size(); i++) {
+			if (args[i] == 0) {
+				writeClauseLits(args.data() + clause_start, i - clause_start);
+				clause_start = i + 1;
+			}
+		}
+		return;
+	}
+	int id = findKeyword(keyword);
+	if (id < 0) {
+		writeText(begin, end);
+		return;
+	}
+	writeVarint(((uint64_t) id << 1) + 3);
+	writeVarint(args.size());
+	for (int64_t arg : args)
+		writeSigned(arg);
+	if (id == 0) {
+		//solve: make sure that the file is complete up to this point, in case the solver doesn't return
+		flush();
+	}
+}
+
+void BinaryGNFReader::readHeader() {
+	for (int i = 0; i < 4; i++) {
+		if (*in != BinaryGNF::magic[i])
+			parse_errorf("Not a binary GNF file\n");
+		++in;
+	}
+	format_version = readVarint();
+	if (format_version < 1 || format_version > BinaryGNF::version)
+		parse_errorf("Unsupported binary GNF version %d (versions up to %d are supported)\n", format_version,
+				BinaryGNF::version);
+}
+
+uint64_t BinaryGNFReader::readVarint() {
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		int c = *in;
+		if (c == EOF)
+			parse_errorf("Truncated binary GNF file\n");
+		++in;
+		value |= (uint64_t) (c & 0x7F) << shift;
+		if (!(c & 0x80))
+			return value;
+	}
+	parse_errorf("Bad integer in binary GNF file\n");
+	return 0;
+}
+
+static void appendInt(vec<char> & text, int64_t value) {
+	char digits[24];
+	int n = 0;
+	uint64_t v = value < 0 ? -(uint64_t) value : value;
+	do {
+		digits[n++] = '0' + (v % 10);
+		v /= 10;
+	} while (v);
+	if (value < 0)
+		text.push('-');
+	while (n > 0)
+		text.push(digits[--n]);
+}
+
+bool BinaryGNFReader::readRecord() {
+	if (!format_version)
+		readHeader();
+	if (*in == EOF)
+		return false;
+	uint64_t tag = readVarint();
+	text.clear();
+	text_pos = 0;
+	if ((tag & 1) == 0) {
+		uint64_t n = tag >> 1;
+		clause.clear();
+		int64_t prev_var = clause_var;
+		for (uint64_t i = 0; i < n; i++) {
+			uint64_t value = readVarint();
+			int64_t var = prev_var + unzigzag(value >> 1);
+			if (var <= 0 || var > INT_MAX)
+				parse_errorf("Bad literal in binary GNF file\n");
+			clause.push((value & 1) ? -(int) var : (int) var);
+			prev_var = var;
+			if (i == 0)
+				clause_var = var;
+		}
+		clause_pending = true;
+	} else if (tag == 1) {
+		uint64_t length = readVarint();
+		for (uint64_t i = 0; i < length; i++) {
+			if (*in == EOF)
+				parse_errorf("Truncated binary GNF file\n");
+			text.push((char) *in);
+			++in;
+		}
+		text.push('\n');
+	} else {
+		uint64_t id = (tag - 3) >> 1;
+		if (id >= n_keywords)
+			parse_errorf("Unknown record %lu in binary GNF file\n", (unsigned long) tag);
+		for (const char * k = keywords[id]; *k; k++)
+			text.push(*k);
+		uint64_t n_args = readVarint();
+		for (uint64_t i = 0; i < n_args; i++) {
+			text.push(' ');
+			appendInt(text, readSigned());
+		}
+		text.push('\n');
+	}
+	return true;
+}
+
+void BinaryGNFReader::formatClause() {
+	assert(clause_pending);
+	text.clear();
+	text_pos = 0;
+	for (int l : clause) {
+		appendInt(text, l);
+		text.push(' ');
+	}
+	text.push('0');
+	text.push('\n');
+	clause_pending = false;
+}
+
+bool BinaryGNFReader::readLine(vec<char> & linebuf) {
+	linebuf.clear();
+	if (!fill()) {
+		linebuf.push(0);
+		return false;
+	}
+	if (clause_pending)
+		formatClause();
+	for (; text_pos < text.size(); text_pos++)
+		linebuf.push(text[text_pos]);
+	linebuf.push(0);
+	return true;
+}
@@ -0,0 +1,224 @@
+/****************************************************************************************[BinaryGNF.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+#ifndef Monosat_BinaryGNF_h
+#define Monosat_BinaryGNF_h
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "monosat/core/SolverTypes.h"
+#include "monosat/mtl/Vec.h"
+#include "monosat/utils/ParseUtils.h"
+
+namespace Monosat {
+
+/**
+ * Binary GNF is a compact encoding of the same stream of constraints as a (text) GNF file.
+ *
+ * A binary GNF file starts with the 4 bytes 0x7F 'G' 'N' 'F', followed by the format version, and then a sequence
+ * of records, each of which encodes one line of text GNF. All integers are varints (7 bits per byte, least
+ * significant first), and signed integers are zigzag encoded first, so that small negative numbers are also short.
+ * Each record starts with a tag:
+ *  - An even tag 2n is a clause of n literals, followed by its literals. As the variables of consecutive literals
+ *    tend to be close together (for example, in Tseitin encodings), each literal is stored as the (signed) difference
+ *    between its variable and the variable of the previous literal (or, for the first literal of a clause, of the
+ *    first literal of the previous clause), shifted left by one bit, with the lowest bit set if the literal is negative.
+ *  - Tag 1 is a line of text, followed by its length and its characters (without the newline).
+ *    Lines that don't fit any other record (comments, symbols, floating point edge weights, etc.) are stored this way.
+ *  - Any other tag 2k+3 is a line starting with the k'th keyword of the format (such as "edge", "bv const <",
+ *    "pb >=" or "transition"), followed by the number of arguments, and then its (signed, 64-bit) integer arguments.
+ *
+ * The keywords are listed in BinaryGNF.cpp; their order is part of the format, and new keywords may only be
+ * appended to the end of the list, along with an increment of the format version.
+ */
+namespace BinaryGNF {
+static const unsigned char magic[4] = { 0x7F, 'G', 'N', 'F' };
+static const int version = 1;
+}
+
+//True if the stream starts with a binary GNF file, rather than text (neither of which is consumed).
+static inline bool isBinaryGNF(StreamBuffer & in) {
+	return *in == BinaryGNF::magic[0];
+}
+
+/**
+ * Writes binary GNF to a file, which it takes ownership of.
+ * Records are buffered, and written out when the buffer is full, after each 'solve' line, and by flush().
+ */
+class BinaryGNFWriter {
+	FILE * out;
+	std::vector<unsigned char> buf;
+	//text passed to write() that doesn't yet end in a newline
+	std::string partial_line;
+	std::vector<int64_t> args;
+	std::string keyword;
+	//the variable of the first literal of the last clause
+	int64_t clause_var = 0;
+	bool ok = true;
+
+	void writeVarint(uint64_t value) {
+		while (value >= 0x80) {
+			buf.push_back((unsigned char) (value | 0x80));
+			value >>= 7;
+		}
+		buf.push_back((unsigned char) value);
+	}
+	static uint64_t zigzag(int64_t value) {
+		return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+	}
+	void writeSigned(int64_t value) {
+		writeVarint(zigzag(value));
+	}
+	template<class L>
+	void writeClauseLits(const L * lits, size_t n);
+	void writeText(const char * begin, const char * end);
+	void encodeLine(const char * begin, const char * end);
+public:
+	static const size_t buffer_size = 1 << 20;
+
+	explicit BinaryGNFWriter(FILE * out);
+	~BinaryGNFWriter();
+
+	BinaryGNFWriter(const BinaryGNFWriter &) = delete;
+	BinaryGNFWriter & operator=(const BinaryGNFWriter &) = delete;
+
+	/**
+	 * Encode text GNF. The text may end in the middle of a line, in which case the rest of that line is expected
+	 * in the next call.
+	 * Returns false if writing to the file has failed.
+	 */
+	bool write(const char * text, size_t length);
+
+	//Encode a clause directly, without formatting it as text first.
+	bool writeClause(const vec<Lit> & clause);
+
+	//Write out all buffered records. Returns false if writing to the file has failed.
+	bool flush();
+};
+
+/**
+ * Reads binary GNF, presenting it to the parser as the equivalent text GNF, with the same interface as StreamBuffer.
+ * Clause records are passed to the parser as already tokenized literals (see readPretokenizedClause()),
+ * and so are never formatted as text; any other record is expanded into its line of text as it is read.
+ */
+class BinaryGNFReader {
+	StreamBuffer & in;
+	//0 until the header has been read
+	int format_version = 0;
+	//the text of the current record, and the position of the parser in it
+	vec<char> text;
+	int text_pos = 0;
+	//the literals of the current record, if it is a clause that has not been read yet
+	vec<int> clause;
+	bool clause_pending = false;
+	//the variable of the first literal of the last clause
+	int64_t clause_var = 0;
+
+	uint64_t readVarint();
+	static int64_t unzigzag(uint64_t value) {
+		return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+	}
+	int64_t readSigned() {
+		return unzigzag(readVarint());
+	}
+	void readHeader();
+	bool readRecord();
+	void formatClause();
+
+	//Returns false at the end of the file
+	bool fill() {
+		while (!clause_pending && text_pos >= text.size()) {
+			if (!readRecord())
+				return false;
+		}
+		return true;
+	}
+public:
+	//The header of the file is checked when the first record is read (throwing a parse_error if the stream
+	//isn't binary GNF of a supported version).
+	explicit BinaryGNFReader(StreamBuffer & in) :
+			in(in) {
+	}
+
+	BinaryGNFReader(const BinaryGNFReader &) = delete;
+	BinaryGNFReader & operator=(const BinaryGNFReader &) = delete;
+
+	int operator *() {
+		if (!fill())
+			return EOF;
+		if (clause_pending) {
+			//the first character of the clause, had it been written as text
+			if (clause.size() == 0)
+				return '0';
+			if (clause[0] < 0)
+				return '-';
+			int lead = clause[0];
+			while (lead >= 10)
+				lead /= 10;
+			return '0' + lead;
+		}
+		return (unsigned char) text[text_pos];
+	}
+	void operator ++() {
+		if (!fill())
+			return;
+		if (clause_pending)
+			formatClause();
+		text_pos++;
+	}
+	void operator +=(int n) {
+		assert(n >= 0);
+		for (int i = 0; i < n; i++)
+			this->operator ++();
+	}
+
+	/**
+	 * If the parser is at the start of a clause record, point lits to its n_lits literals
+	 * (in DIMACS format, without the terminating 0), advance past the clause, and return true.
+	 */
+	bool nextClause(const int *& lits, int & n_lits) {
+		if (!fill() || !clause_pending)
+			return false;
+		lits = clause.begin();
+		n_lits = clause.size();
+		clause_pending = false;
+		return true;
+	}
+
+	/**
+	 * Copy the remainder of the current line, including its newline, into linebuf, followed by a 0, and advance past it.
+	 * Returns false at the end of the file.
+	 */
+	bool readLine(vec<char> & linebuf);
+};
+
+static inline bool isEof(BinaryGNFReader & in) {
+	return *in == EOF;
+}
+
+static inline bool readPretokenizedClause(BinaryGNFReader & in, const int *& lits, int & n_lits) {
+	return in.nextClause(lits, n_lits);
+}
+
+}
+
+#endif
@@ -52,6 +52,13 @@ DoubleOption Monosat::opt_random_seed(_cat, "rnd-seed", "Used by the random vari
 		DoubleRange(0, false, HUGE_VAL, false));
 IntOption Monosat::opt_ccmin_mode(_cat, "ccmin-mode", "Controls conflict clause minimization (0=none, 1=basic, 2=deep)",
 		2, IntRange(0, 2));
+BoolOption Monosat::opt_lbd_tiers(_cat, "lbd-tiers",
+		"Sort learnt clauses into core, tier 2, local and theory tiers by their LBD, and reduce the learnt clause database by LBD and activity (instead of by activity alone)",
+		true);
+IntOption Monosat::opt_lbd_core(_cat, "lbd-core", "Learnt clauses with an LBD at or below this are kept permanently (if lbd-tiers is enabled)",
+		2, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_lbd_tier2(_cat, "lbd-tier2", "Learnt clauses with an LBD at or below this are kept while they remain in use (if lbd-tiers is enabled)",
+		6, IntRange(0, INT32_MAX));
 IntOption Monosat::opt_phase_saving(_cat, "phase-saving",
 		"Controls the level of phase saving (0=none, 1=limited, 2=full)", 2, IntRange(0, 2));
 BoolOption Monosat::opt_rnd_init_act(_cat, "rnd-init", "Randomize the initial activity", false);
@@ -59,10 +66,41 @@ BoolOption Monosat::opt_luby_restart(_cat, "luby", "Use the Luby restart sequenc
 IntOption Monosat::opt_restart_first(_cat, "rfirst", "The base restart interval", 100, IntRange(1, INT32_MAX));
 DoubleOption Monosat::opt_restart_inc(_cat, "rinc", "Restart interval increase factor", 2,
 		DoubleRange(1, false, HUGE_VAL, false));
+BoolOption Monosat::opt_ema_restarts(_cat, "ema-restarts",
+		"Restart (in focused mode) when the short term average LBD of learnt clauses rises above the long term average, as in Glucose, instead of following the Luby or geometric sequence",
+		false);
+DoubleOption Monosat::opt_ema_restart_margin(_cat, "ema-restart-margin",
+		"Restart when the short term average LBD exceeds the long term average by this factor (if ema-restarts is enabled)", 1.25,
+		DoubleRange(0, false, HUGE_VAL, false));
+IntOption Monosat::opt_ema_restart_min(_cat, "ema-restart-min",
+		"Minimum number of conflicts between restarts (if ema-restarts is enabled)", 50, IntRange(1, INT32_MAX));
+DoubleOption Monosat::opt_ema_restart_block(_cat, "ema-restart-block",
+		"Postpone restarts while the trail is longer than this factor times its average length at conflicts, as in Glucose (0 to disable; if ema-restarts is enabled)",
+		1.4, DoubleRange(0, true, HUGE_VAL, false));
+IntOption Monosat::opt_mode_switch(_cat, "mode-switch",
+		"Alternate between focused mode (frequent restarts) and stable mode (rare, Luby restarts, and target phases) after this many conflicts, doubling the interval after each stable phase (0 to stay in focused mode)",
+		0, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_stable_restart_first(_cat, "stable-rfirst", "The base restart interval in stable mode (see mode-switch)", 1024,
+		IntRange(1, INT32_MAX));
+IntOption Monosat::opt_target_phase(_cat, "target-phase",
+		"Decide the polarity of each variable in the largest conflict-free assignment since the last rephase or mode switch (0=never, 1=in stable mode, 2=always)",
+		1, IntRange(0, 2));
+IntOption Monosat::opt_rephase(_cat, "rephase",
+		"Every this many conflicts, reset the saved phases, cycling between the best assignment found so far, the original phases, and the inverted phases (0 to disable)",
+		0, IntRange(0, INT32_MAX));
 DoubleOption Monosat::opt_garbage_frac(_cat, "gc-frac",
 		"The fraction of wasted memory allowed before a garbage collection is triggered", 0.20,
 		DoubleRange(0, false, HUGE_VAL, false));
 BoolOption Monosat::opt_pre("MAIN", "pre", "Completely turn on/off any preprocessing.", true);
+IntOption Monosat::opt_portfolio("MAIN", "portfolio",
+		"Solve with this many differently configured copies of the solver, each in its own thread, keeping the first answer (0 or 1 to disable)",
+		0, IntRange(0, 256));
+IntOption Monosat::opt_portfolio_share(_cat, "portfolio-share",
+		"Share learnt clauses of at most this many literals between the solvers of a portfolio (0 to disable)", 2,
+		IntRange(0, INT32_MAX));
+IntOption Monosat::opt_parse_threads("MAIN", "parse-threads",
+		"Memory map uncompressed input files, and tokenize their clauses in parallel with this many threads (0: one per core; -1: read all input through zlib, one character at a time)",
+		0, IntRange(-1, 1024));
 IntOption Monosat::opt_time(_cat, "verb-time", "Detail level of timing benchmarks (these add some overhead)", 0,
 		IntRange(0, 5));
 
@@ -86,6 +124,10 @@ StringOption Monosat::opt_debug_learnt_clauses(_cat, "debug-learnts",
 		"Write all learnt clauses to the following file (empty string (recommended) disables)", "");
 FILE* Monosat::opt_write_learnt_clauses = nullptr;
 
+StringOption Monosat::opt_drat_file(_cat, "drat",
+		"Write a DRAT proof of unsatisfiability to the following file, with theory lemmas as trusted steps (empty string (default) disables)", "");
+BoolOption Monosat::opt_drat_binary(_cat, "drat-binary", "Write the DRAT proof in binary, rather than text, format", true);
+
 //StringOption Monosat::StringOption opt_fsm_model(_cat_fsm,"File to write fsm model, if fsm theory is used","","");
 
 BoolOption Monosat::opt_write_bv_analysis(_cat, "debug-analysis","",false);
@@ -138,10 +180,10 @@ BoolOption Monosat::opt_graph(_cat_graph, "graph", "Use graph theory solver", tr
 BoolOption Monosat::opt_inc_graph(_cat_graph, "inc", "Use incremental graph reachability", false);
 IntOption Monosat::opt_dec_graph(_cat_graph, "dec", "Use decremental graph reachability", 0, IntRange(0, 2));
 StringOption Monosat::opt_maxflow_alg(_cat_graph, "maxflow",
-		"Select max s-t-flow algorithm (edmondskarp, edmondskarp-adj, edmondskarp-dynamic,dinitz,dinitz-linkcut, kohli-torr)",
+		"Select max s-t-flow algorithm (edmondskarp, edmondskarp-adj, edmondskarp-dynamic,dinitz,dinitz-linkcut, kohli-torr, push-relabel)",
 		"kohli-torr"); //ibfs
 StringOption Monosat::opt_reach_alg(_cat_graph, "reach",
-		"Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf)", "ramal-reps");
+		"Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,multisource,cnf)", "ramal-reps");
 StringOption Monosat::opt_dist_alg(_cat_graph, "dist",
 		"Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf)", "ramal-reps");
 
@@ -153,7 +195,7 @@ StringOption Monosat::opt_mst_alg(_cat_graph, "mst", "Select minimum spanning tr
 		"spira-pan");
 
 StringOption Monosat::opt_allpairs_alg(_cat_graph, "allpairs",
-		"Select allpairs reachability algorithm (floyd-warshall,dijkstra)", "floyd-warshall");
+		"Select allpairs reachability algorithm (incremental,floyd-warshall,dijkstra)", "incremental");
 StringOption Monosat::opt_components_alg(_cat_graph, "components",
 		"Select connected-components algorithm (disjoint-sets, link-cut)", "disjoint-sets");
 StringOption Monosat::opt_cycle_alg(_cat_graph, "cycles",
@@ -167,6 +209,8 @@ BoolOption Monosat::opt_conflict_1uip(_cat_graph, "conflict-1uip",
 		"Use 1 uip (instead of arbitrary or min cut) for conflict resolution (in theories that support this)", false);
 BoolOption Monosat::opt_conflict_min_cut_maxflow(_cat_graph, "conflict-min-cut-maxflow",
 		"Use min-cut (instead of arbitrary cut) for conflict resolution for maximum flow properties", false);
+BoolOption Monosat::opt_maxflow_cut_tree(_cat_graph, "maxflow-cut-tree",
+		"Share a Gomory-Hu cut tree between the maximum flow constraints of each graph, and use its cuts to bound (and explain) their flows, instead of computing an over-approximate maximum flow for each constraint", false);
 
 IntOption Monosat::opt_history_clear(_cat_graph, "history-clear",
 		"Rate at which the history of dynamic graphs is cleared", 100000, IntRange(1, INT32_MAX));
@@ -326,6 +370,12 @@ BoolOption Monosat::opt_dinics_recursive(_cat_graph, "dinitz-recursive",
 IntOption  Monosat::opt_graph_prop_skip(_cat_graph, "graph-theory-skip",
 		"Only process every nth graph theory propagation ('1' skips no propagations)",1, IntRange(1,INT32_MAX));
 
+IntOption  Monosat::opt_parallel_detectors(_cat_graph, "parallel-detectors",
+		"Number of threads used to update the graph algorithms of independent detectors during graph theory propagation ('0' or '1' updates them sequentially)",0, IntRange(0,1024));
+
+BoolOption Monosat::opt_graph_csr(_cat_graph, "graph-csr",
+		"Pack each graph's adjacency lists into flat (compressed sparse row) arrays once its edges have been declared", true);
+
 IntOption  Monosat::opt_bv_prop_skip(_cat_bv, "bv-theory-skip",
 		"Only process every nth bv theory propagation ('1' skips no propagations)",1, IntRange(1,INT32_MAX));
 
@@ -358,7 +408,7 @@ MinCutAlg Monosat::mincutalg = MinCutAlg::ALG_EDMONSKARP;
 ReachAlg Monosat::reachalg = ReachAlg::ALG_RAMAL_REPS;
 ConnectivityAlg Monosat::undirectedalg = ConnectivityAlg::ALG_DFS;
 DistAlg Monosat::distalg = DistAlg::ALG_RAMAL_REPS;
-AllPairsAlg Monosat::allpairsalg = AllPairsAlg::ALG_DIJKSTRA_ALLPAIRS;
+AllPairsAlg Monosat::allpairsalg = AllPairsAlg::ALG_INCREMENTAL_ALLPAIRS;
 AllPairsConnectivityAlg Monosat::undirected_allpairsalg = AllPairsConnectivityAlg::ALG_DIJKSTRA_ALLPAIRS;
 ComponentsAlg Monosat::componentsalg = ComponentsAlg::ALG_DISJOINT_SETS;
 MinSpanAlg Monosat::mstalg = MinSpanAlg::ALG_KRUSKAL;
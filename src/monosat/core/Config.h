@@ -32,12 +32,26 @@ extern DoubleOption opt_theory_decay;
 extern DoubleOption opt_random_var_freq;
 extern DoubleOption opt_random_seed;
 extern IntOption opt_ccmin_mode;
+extern BoolOption opt_lbd_tiers;
+extern IntOption opt_lbd_core;
+extern IntOption opt_lbd_tier2;
 extern IntOption opt_phase_saving;
 extern BoolOption opt_rnd_init_act;
 extern BoolOption opt_luby_restart;
 extern IntOption opt_restart_first;
 extern DoubleOption opt_restart_inc;
+extern BoolOption opt_ema_restarts;
+extern DoubleOption opt_ema_restart_margin;
+extern IntOption opt_ema_restart_min;
+extern DoubleOption opt_ema_restart_block;
+extern IntOption opt_mode_switch;
+extern IntOption opt_stable_restart_first;
+extern IntOption opt_target_phase;
+extern IntOption opt_rephase;
 extern DoubleOption opt_garbage_frac;
+extern IntOption opt_portfolio;
+extern IntOption opt_portfolio_share;
+extern IntOption opt_parse_threads;
 extern BoolOption opt_rnd_restart;
 extern BoolOption opt_rnd_theory_restart;
 extern StringOption opt_record_file;
@@ -67,6 +81,8 @@ extern long opt_n_learnts;
 extern BoolOption opt_write_bv_bounds;
 extern BoolOption opt_write_bv_analysis;
 extern FILE* opt_write_learnt_clauses;
+extern StringOption opt_drat_file;
+extern BoolOption opt_drat_binary;
 //extern StringOption opt_fsm_model;
 
 extern BoolOption opt_graph;
@@ -170,6 +186,7 @@ extern BoolOption opt_conflict_1uip;
 extern BoolOption opt_use_kt_for_conflicts;
 //extern BoolOption opt_maxflow_backward;
 extern BoolOption opt_conflict_min_cut_maxflow;
+extern BoolOption opt_maxflow_cut_tree;
 extern IntOption opt_history_clear;
 extern BoolOption opt_kt_preserve_order;
 
@@ -184,6 +201,8 @@ extern BoolOption opt_shortest_path_prune_dist;
 extern BoolOption opt_graph_bv_prop;
 
 extern IntOption opt_graph_prop_skip;
+extern IntOption opt_parallel_detectors;
+extern BoolOption opt_graph_csr;
 extern IntOption opt_bv_prop_skip;
 extern IntOption opt_fsm_prop_skip;
 
@@ -203,7 +222,7 @@ enum class PointInPolygonAlg {
 extern PointInPolygonAlg pipalg;
 
 enum class ReachAlg {
-	ALG_SAT, ALG_DFS, ALG_DIJKSTRA, ALG_DISTANCE, ALG_BFS, ALG_RAMAL_REPS
+	ALG_SAT, ALG_DFS, ALG_DIJKSTRA, ALG_DISTANCE, ALG_BFS, ALG_RAMAL_REPS, ALG_MULTISOURCE
 };
 
 //For undirected reachability
@@ -214,7 +233,7 @@ extern ConnectivityAlg undirectedalg;
 extern ReachAlg reachalg;
 
 enum class AllPairsAlg {
-	ALG_FLOYDWARSHALL, ALG_DIJKSTRA_ALLPAIRS
+	ALG_FLOYDWARSHALL, ALG_DIJKSTRA_ALLPAIRS, ALG_INCREMENTAL_ALLPAIRS
 };
 extern AllPairsAlg allpairsalg;
 enum class AllPairsConnectivityAlg {
@@ -227,7 +246,8 @@ enum class MinCutAlg {
 	ALG_EDKARP_DYN,
 	ALG_DINITZ,
 	ALG_DINITZ_LINKCUT,
-	ALG_KOHLI_TORR
+	ALG_KOHLI_TORR,
+	ALG_PUSH_RELABEL
 };
 extern MinCutAlg mincutalg;
 enum class MinSpanAlg {
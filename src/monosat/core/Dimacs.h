@@ -26,6 +26,8 @@
 #include <stdio.h>
 #include "monosat/core/Config.h"
 #include "monosat/utils/ParseUtils.h"
+#include "monosat/utils/MappedBuffer.h"
+#include "monosat/core/BinaryGNF.h"
 #include "monosat/core/SolverTypes.h"
 #include "monosat/core/Optimize.h"
 #include "monosat/mtl/Vec.h"
@@ -204,9 +206,21 @@ public:
 private:
 
 
-	void readClause(B& in, Solver& S, vec<Lit>& lits) {
+	template<class In>
+	void readClause(In& in, Solver& S, vec<Lit>& lits) {
 		int parsed_lit, var;
 		lits.clear();
+		const int * tokens;
+		int n_tokens;
+		if (readPretokenizedClause(in, tokens, n_tokens)) {
+			for (int i = 0; i < n_tokens; i++) {
+				parsed_lit = tokens[i];
+				var = abs(parsed_lit) - 1;
+				var = mapVar(S,var);
+				lits.push((parsed_lit > 0) ? mkLit(var) : ~mkLit(var));
+			}
+			return;
+		}
 		for (;;) {
 			parsed_lit = parseInt(in);
 			if (parsed_lit == 0)
@@ -240,7 +254,14 @@ private:
 		return false;
 	}
 	
-	bool readLine(vec<char> & linebuf, B& in) {
+	bool readLine(vec<char> & linebuf, MappedBuffer& in) {
+		return in.readLine(linebuf);
+	}
+	bool readLine(vec<char> & linebuf, BinaryGNFReader& in) {
+		return in.readLine(linebuf);
+	}
+	template<class In>
+	bool readLine(vec<char> & linebuf, In& in) {
 		linebuf.clear();
 		for (;;) {
 			if (isEof(in))
@@ -262,7 +283,8 @@ private:
 	int clause_count=0;
 	int line_num=0;
 	int solves=0;
-	bool parse_(B& in, Solver& S) {
+	template<class In>
+	bool parse_(In& in, Solver& S) {
 		vec<Lit> lits;
 		if(opt_remap_vars){
 			S.setVarMap(this);
@@ -471,6 +493,12 @@ public:
 	bool parse(StreamBuffer & in, Solver& S) {
 		return parse_(in,S);
 	}
+	bool parse(MappedBuffer & in, Solver& S) {
+		return parse_(in,S);
+	}
+	bool parse(BinaryGNFReader & in, Solver& S) {
+		return parse_(in,S);
+	}
 };
 }
 ;
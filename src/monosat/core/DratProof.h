@@ -0,0 +1,127 @@
+/****************************************************************************************[DratProof.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+#ifndef Monosat_DratProof_h
+#define Monosat_DratProof_h
+
+#include <cstdio>
+#include <vector>
+#include "monosat/core/SolverTypes.h"
+
+namespace Monosat {
+
+/**
+ * Writes a DRAT proof of unsatisfiability, in either the binary or the text format read by drat-trim.
+ *
+ * Each step adds or deletes one clause. In binary DRAT, a step is the byte 'a' (add) or 'd' (delete), followed by
+ * the clause's literals, each as the varint (7 bits per byte, least significant first) 2*v + (1 if negative),
+ * where v is the literal's (1-based) DIMACS variable, and then a 0 byte. In text DRAT, a step is a line of DIMACS
+ * literals ending in 0, prefixed by "d " for deletions.
+ *
+ * Clauses learnt from the SAT solver's own conflicts are RUP (reverse unit propagation) steps, but theory lemmas
+ * (theory conflicts, and the reasons for theory propagations) are not implied by the clauses of the proof.
+ * These are written as trusted lemma steps, with the tag 't' (in binary) or the prefix "t " (in text), which a
+ * checker must either accept as new premises or verify against the theory separately. Proofs of problems without
+ * theories contain no such steps, and can be checked directly against the input CNF.
+ *
+ * Steps are buffered, and written out when the buffer is full, and by flush().
+ */
+class DratWriter {
+	FILE * out;
+	bool binary;
+	std::vector<unsigned char> buf;
+	bool ok = true;
+
+	void writeVarint(unsigned value) {
+		while (value >= 0x80) {
+			buf.push_back((unsigned char) (value | 0x80));
+			value >>= 7;
+		}
+		buf.push_back((unsigned char) value);
+	}
+	void writeText(const char * text) {
+		while (*text)
+			buf.push_back((unsigned char) *text++);
+	}
+public:
+	static const char Add = 'a';
+	static const char Delete = 'd';
+	static const char Theory = 't';
+
+	static const size_t buffer_size = 1 << 20;
+
+	//Takes ownership of 'out', which is closed when the writer is deleted.
+	DratWriter(FILE * out, bool binary) :
+			out(out), binary(binary) {
+		buf.reserve(buffer_size + 1024);
+	}
+	~DratWriter() {
+		flush();
+		fclose(out);
+	}
+
+	DratWriter(const DratWriter &) = delete;
+	DratWriter & operator=(const DratWriter &) = delete;
+
+	//Start a step of the given kind (Add, Delete or Theory); its literals follow, and then end().
+	inline void begin(char step) {
+		if (binary)
+			buf.push_back((unsigned char) step);
+		else if (step == Delete)
+			writeText("d ");
+		else if (step == Theory)
+			writeText("t ");
+	}
+
+	//Write one literal (in the numbering of the input problem) of the current step.
+	inline void lit(Lit l) {
+		if (binary) {
+			writeVarint(2 * (var(l) + 1) + sign(l));
+		} else {
+			char text[16];
+			snprintf(text, sizeof(text), "%d ", dimacs(l));
+			writeText(text);
+		}
+	}
+
+	inline void end() {
+		if (binary)
+			buf.push_back(0);
+		else
+			writeText("0\n");
+		if (buf.size() >= buffer_size)
+			flush();
+	}
+
+	//Write out all buffered steps. Returns false if writing to the file has failed.
+	bool flush() {
+		if (buf.size()) {
+			if (fwrite(buf.data(), 1, buf.size(), out) != buf.size())
+				ok = false;
+			buf.clear();
+		}
+		if (fflush(out) != 0)
+			ok = false;
+		return ok;
+	}
+};
+
+}
+#endif
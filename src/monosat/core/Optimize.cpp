@@ -30,6 +30,8 @@
 #include <string>
 #include <cstdint>
 #include <limits>
+#include <mutex>
+#include <set>
 namespace Monosat{
 
 namespace Optimization{
@@ -41,7 +43,11 @@ static rlim_t system_time_limit;
 static bool has_system_mem_limit=false;
 static rlim_t system_mem_limit;
 
-static Solver * solver;
+//Solvers that are currently optimizing under the limits above.
+//Several solvers may optimize concurrently (in different threads), but the limits themselves are process wide,
+//so they are installed by the first of these solvers and restored once the last one has finished.
+static std::set<Solver*> solvers;
+static std::mutex solvers_lock;
 
 static sighandler_t system_sigxcpu_handler = nullptr;
 
@@ -57,26 +63,30 @@ struct initializer {
 	}
 
 	~initializer() {
-		solver =nullptr;
+		solvers.clear();
 	}
 };
 static initializer i;
 }
-void disableResourceLimits(Solver * S);
+static void restoreResourceLimits();
 static void SIGNAL_HANDLER_api(int signum) {
-	if(solver){
+	//Don't block on solvers_lock, which may be held by the thread this signal was delivered to;
+	//if it is unavailable, SIGXCPU will be sent again after the next second of cpu time.
+	std::unique_lock<std::mutex> guard(solvers_lock,std::try_to_lock);
+	if(guard.owns_lock() && solvers.size()){
 		fprintf(stderr,"Monosat resource limit reached\n");
-		Solver * s = solver;
-		disableResourceLimits(s);
-		s->interrupt();
+		restoreResourceLimits();
+		for(Solver * s:solvers)
+			s->interrupt();
+		solvers.clear();
 	}
 }
 
 
 void enableResourceLimits(Solver * S){
-	if(!solver){
-		assert(solver==nullptr);
-		solver=S;
+	std::lock_guard<std::mutex> guard(solvers_lock);
+	solvers.insert(S);
+	if(solvers.size()==1){
 
 		struct rusage ru;
 		getrusage(RUSAGE_SELF, &ru);
@@ -131,41 +141,45 @@ void enableResourceLimits(Solver * S){
 }
 
 void disableResourceLimits(Solver * S){
-	if(solver){
+	std::lock_guard<std::mutex> guard(solvers_lock);
+	if(solvers.erase(S) && solvers.size()==0){
+		restoreResourceLimits();
+	}
+}
 
-		solver=nullptr;
-		rlimit rl;
-		getrlimit(RLIMIT_CPU, &rl);
-		if(has_system_time_limit){
-			has_system_time_limit=false;
-			if (rl.rlim_max == RLIM_INFINITY || (rlim_t)system_time_limit < rl.rlim_max) {
-				rl.rlim_cur = system_time_limit;
-				if (setrlimit(RLIMIT_CPU, &rl) == -1)
-					fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
-			}else{
-				rl.rlim_cur = rl.rlim_max;
-				if (setrlimit(RLIMIT_CPU, &rl) == -1)
-					fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
-			}
-		}
-		getrlimit(RLIMIT_AS, &rl);
-		if(has_system_mem_limit){
-			has_system_mem_limit=false;
-			if (rl.rlim_max == RLIM_INFINITY || system_mem_limit < rl.rlim_max) {
-				rl.rlim_cur = system_mem_limit;
-				if (setrlimit(RLIMIT_AS, &rl) == -1)
-					fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
-			}else{
-				rl.rlim_cur = rl.rlim_max;
-				if (setrlimit(RLIMIT_AS, &rl) == -1)
-					fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
-			}
+//Caller must hold solvers_lock
+static void restoreResourceLimits(){
+	rlimit rl;
+	getrlimit(RLIMIT_CPU, &rl);
+	if(has_system_time_limit){
+		has_system_time_limit=false;
+		if (rl.rlim_max == RLIM_INFINITY || (rlim_t)system_time_limit < rl.rlim_max) {
+			rl.rlim_cur = system_time_limit;
+			if (setrlimit(RLIMIT_CPU, &rl) == -1)
+				fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
+		}else{
+			rl.rlim_cur = rl.rlim_max;
+			if (setrlimit(RLIMIT_CPU, &rl) == -1)
+				fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
 		}
-		if (system_sigxcpu_handler){
-			signal(SIGXCPU, system_sigxcpu_handler);
-			system_sigxcpu_handler=nullptr;
+	}
+	getrlimit(RLIMIT_AS, &rl);
+	if(has_system_mem_limit){
+		has_system_mem_limit=false;
+		if (rl.rlim_max == RLIM_INFINITY || system_mem_limit < rl.rlim_max) {
+			rl.rlim_cur = system_mem_limit;
+			if (setrlimit(RLIMIT_AS, &rl) == -1)
+				fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
+		}else{
+			rl.rlim_cur = rl.rlim_max;
+			if (setrlimit(RLIMIT_AS, &rl) == -1)
+				fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
 		}
 	}
+	if (system_sigxcpu_handler){
+		signal(SIGXCPU, system_sigxcpu_handler);
+		system_sigxcpu_handler=nullptr;
+	}
 }
 }
 
@@ -853,7 +867,7 @@ lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objec
     vec<int64_t> model_vals;
 	for(Lit l:assumes)
 		assume.push(l);
-	static int solve_runs=0;
+	static thread_local int solve_runs=0;
 	found_optimal=true;
 	solve_runs++;
 	if(opt_verb>=1){
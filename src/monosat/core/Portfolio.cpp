@@ -0,0 +1,203 @@
+/****************************************************************************************[Portfolio.cpp]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/Portfolio.h"
+#include "monosat/simp/SimpSolver.h"
+#include <cstdio>
+#include <exception>
+#include <thread>
+
+using namespace Monosat;
+
+SolverConfig Monosat::getPortfolioConfig(const SolverConfig & base, int worker) {
+	SolverConfig config = base;
+	if (worker == 0)
+		return config;
+	config.random_seed = base.random_seed + worker * 1000003;
+	switch ((worker - 1) % 5) {
+	case 0:
+		config.decide_theories = !base.decide_theories;
+		break;
+	case 1:
+		config.lazy_backtrack = !base.lazy_backtrack;
+		config.reach_alg = ReachAlg::ALG_DFS;
+		break;
+	case 2:
+		config.reach_alg = ReachAlg::ALG_MULTISOURCE;
+		config.mincut_alg = MinCutAlg::ALG_DINITZ;
+		break;
+	case 3:
+		config.decide_theories = !base.decide_theories;
+		config.mincut_alg = MinCutAlg::ALG_DINITZ_LINKCUT;
+		config.dist_alg = DistAlg::ALG_RAMAL_REPS;
+		break;
+	default:
+		//random seed only
+		break;
+	}
+	return config;
+}
+
+lbool Portfolio::solve(SimpSolver & S, PortfolioMember & main,
+		const std::function<lbool(bool & found_optimal)> & solve_main,
+		const std::function<lbool(SimpSolver & W, PortfolioMember & member, bool & found_optimal)> & solve_worker,
+		bool & found_optimal) {
+	std::vector<std::thread> threads;
+	for (int i = 1; i < n_workers; i++) {
+		threads.emplace_back([this, i, &S, &solve_worker]() {
+			SimpSolver W(getPortfolioConfig(S.getConfig(), i));
+			W.verbosity = 0;
+			PortfolioMember member(*this, i);
+			W.portfolio = &member;
+			setSolver(i, &W);
+			bool optimal = true;
+			lbool r = l_Undef;
+			try {
+				if (!cancelled(i))
+					r = solve_worker(W, member, optimal);
+			} catch (const std::exception & e) {
+				fprintf(stderr, "Portfolio worker %d failed: %s\n", i, e.what());
+				r = l_Undef;
+			}
+			setSolver(i, nullptr);
+			W.portfolio = nullptr;
+			if (r != l_Undef && finish(i)) {
+				result = r;
+				result_optimal = optimal;
+				if (r == l_True) {
+					for (Var v = 0; v < W.model.size() && v < member.to_external.size(); v++) {
+						Var e = member.to_external[v];
+						if (e != var_Undef) {
+							model.growTo(e + 1, l_Undef);
+							model[e] = W.model[v];
+						}
+					}
+				}
+			}
+		});
+	}
+
+	S.portfolio = &main;
+	setSolver(0, &S);
+	bool main_optimal = true;
+	lbool r = solve_main(main_optimal);
+	setSolver(0, nullptr);
+	S.portfolio = nullptr;
+	if (r != l_Undef && finish(0)) {
+		result = r;
+		result_optimal = main_optimal;
+	}
+	for (std::thread & t : threads)
+		t.join();
+
+	found_optimal = result_optimal;
+	if (getWinner() > 0 && result == l_True) {
+		//Copy the winning model into S, by solving S under the assumption of that model
+		vec<Lit> assume;
+		for (Var e = 0; e < model.size() && e < main.from_external.size(); e++) {
+			Var v = main.from_external[e];
+			if (v != var_Undef && model[e] != l_Undef && !S.isEliminated(v))
+				assume.push(mkLit(v, model[e] == l_False));
+		}
+		if (S.solveLimited(assume, false, false) != l_True) {
+			//the variables that are not shared between the solvers can in principle make this fail
+			fprintf(stderr, "Warning: portfolio model was not accepted, solving again without the portfolio\n");
+			result = solve_main(found_optimal);
+		}
+	}
+	if (S.verbosity > 0) {
+		printf("Portfolio: worker %d of %d finished first (%ld learnt clauses shared)\n", getWinner(), n_workers,
+				stats_shared_clauses);
+	}
+	return result;
+}
+
+void Portfolio::setSolver(int worker, Solver * S) {
+	std::lock_guard<std::mutex> guard(lock);
+	solvers[worker] = S;
+	if (S && cancelled(worker))
+		S->interrupt();
+}
+
+bool Portfolio::finish(int worker) {
+	int expected = -1;
+	if (!winner.compare_exchange_strong(expected, worker))
+		return false;
+	std::lock_guard<std::mutex> guard(lock);
+	for (int i = 0; i < n_workers; i++) {
+		if (i != worker && solvers[i])
+			solvers[i]->interrupt();
+	}
+	return true;
+}
+
+void Portfolio::exportClause(int worker, const std::vector<Lit> & external_clause) {
+	std::lock_guard<std::mutex> guard(lock);
+	shared.push_back( { worker, external_clause });
+	stats_shared_clauses++;
+}
+
+void Portfolio::importClauses(int worker, size_t & next, vec<Lit> & store) {
+	std::lock_guard<std::mutex> guard(lock);
+	for (; next < shared.size(); next++) {
+		if (shared[next].from == worker)
+			continue;
+		for (Lit l : shared[next].lits)
+			store.push(l);
+		store.push(lit_Undef);
+	}
+}
+
+void PortfolioMember::exportLearnt(const vec<Lit> & clause) {
+	tmp_clause.clear();
+	for (Lit l : clause) {
+		Var v = var(l);
+		if (v >= to_external.size() || to_external[v] == var_Undef)
+			return;
+		tmp_clause.push_back(mkLit(to_external[v], sign(l)));
+	}
+	portfolio.exportClause(worker, tmp_clause);
+}
+
+void PortfolioMember::importLearnts(vec<Lit> & store) {
+	tmp_import.clear();
+	portfolio.importClauses(worker, next_import, tmp_import);
+	int clause_start = store.size();
+	bool mapped = true;
+	for (Lit l : tmp_import) {
+		if (l == lit_Undef) {
+			if (mapped) {
+				store.push(lit_Undef);
+			} else {
+				store.shrink(store.size() - clause_start);
+			}
+			clause_start = store.size();
+			mapped = true;
+		} else if (mapped) {
+			Var e = var(l);
+			if (e >= from_external.size() || from_external[e] == var_Undef) {
+				mapped = false;
+			} else {
+				store.push(mkLit(from_external[e], sign(l)));
+			}
+		}
+	}
+}
@@ -0,0 +1,158 @@
+/****************************************************************************************[Portfolio.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PORTFOLIO_H_
+#define PORTFOLIO_H_
+
+#include "monosat/core/SolverConfig.h"
+#include "monosat/core/SolverTypes.h"
+#include "monosat/mtl/Vec.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Monosat {
+class Solver;
+class SimpSolver;
+class PortfolioMember;
+
+/**
+ * Returns the configuration of the given portfolio worker.
+ * Worker 0 keeps the base configuration; every other worker uses its own random seed, and cycles through
+ * alternative reachability and maximum flow algorithms, theory decisions, and lazy backtracking.
+ */
+SolverConfig getPortfolioConfig(const SolverConfig & base, int worker);
+
+/**
+ * Races several differently configured solvers, each working on its own copy of the same problem in its own thread.
+ * The first solver to finish wins, and the others are interrupted (and also check cancelled() at each restart,
+ * in case they were interrupted before they started searching).
+ *
+ * Each copy of the problem may number its variables differently, so solvers exchange learnt clauses and models
+ * in terms of 'external' variables (the variables of the original problem), which each solver's PortfolioMember
+ * maps to and from its own variables. Only clauses over external variables are shared, as theory solvers may
+ * introduce variables of their own.
+ */
+class Portfolio {
+	struct SharedClause {
+		int from;
+		std::vector<Lit> lits;
+	};
+	const int n_workers;
+	const int share_size;
+	std::atomic<int> winner { -1 };
+	std::mutex lock;
+	std::vector<Solver*> solvers;
+	std::vector<SharedClause> shared;
+
+	lbool result = l_Undef;
+	bool result_optimal = true;
+	//the winner's model, over external variables
+	vec<lbool> model;
+public:
+	int64_t stats_shared_clauses = 0;
+
+	Portfolio(int n_workers, int share_size) :
+			n_workers(n_workers), share_size(share_size), solvers(n_workers, nullptr) {
+	}
+
+	int nWorkers() const {
+		return n_workers;
+	}
+	//Learnt clauses of at most this many literals are shared (0 if sharing is disabled)
+	int shareSize() const {
+		return share_size;
+	}
+	int getWinner() const {
+		return winner;
+	}
+	bool cancelled(int worker) const {
+		int w = winner;
+		return w >= 0 && w != worker;
+	}
+
+	/**
+	 * Solves S (which becomes worker 0, and is solved in the calling thread by solve_main), while nWorkers()-1
+	 * other solvers each load and solve their own copy of the problem in solve_worker.
+	 * solve_worker must register each of the new solver's variables that corresponds to an external variable
+	 * with the member's mapVar(); main must already map the variables of S.
+	 * If another worker wins with a satisfying assignment, that assignment is copied back into S (by solving S
+	 * again, assuming the winning model), so that the model can be read from S as usual.
+	 */
+	lbool solve(SimpSolver & S, PortfolioMember & main, const std::function<lbool(bool & found_optimal)> & solve_main,
+			const std::function<lbool(SimpSolver & W, PortfolioMember & member, bool & found_optimal)> & solve_worker,
+			bool & found_optimal);
+
+	//Register (or, with nullptr, unregister) the solver of a worker, so that it can be interrupted when another worker wins.
+	void setSolver(int worker, Solver * S);
+	//Returns true if this worker is the first to finish, in which case all other workers are interrupted.
+	bool finish(int worker);
+
+	void exportClause(int worker, const std::vector<Lit> & external_clause);
+	//Append all clauses (in external variables) shared by other workers since 'next', each followed by lit_Undef
+	void importClauses(int worker, size_t & next, vec<Lit> & store);
+};
+
+/**
+ * One solver's view of a Portfolio, translating between its own variables and the external variables.
+ */
+class PortfolioMember {
+	std::vector<Lit> tmp_clause;
+	vec<Lit> tmp_import;
+	size_t next_import = 0;
+public:
+	Portfolio & portfolio;
+	const int worker;
+	//to_external[v] is the external variable of solver variable v, or var_Undef
+	vec<Var> to_external;
+	//from_external[e] is the solver variable of external variable e, or var_Undef
+	vec<Var> from_external;
+
+	PortfolioMember(Portfolio & portfolio, int worker) :
+			portfolio(portfolio), worker(worker) {
+	}
+
+	void mapVar(Var v, Var external) {
+		to_external.growTo(v + 1, var_Undef);
+		from_external.growTo(external + 1, var_Undef);
+		to_external[v] = external;
+		from_external[external] = v;
+	}
+
+	bool cancelled() const {
+		return portfolio.cancelled(worker);
+	}
+
+	int shareSize() const {
+		return portfolio.shareSize();
+	}
+
+	//Offer a clause learnt by this solver to the other workers (if all of its variables are external)
+	void exportLearnt(const vec<Lit> & clause);
+	//Append the clauses that the other workers have shared since the last call, translated into this solver's
+	//variables, each followed by lit_Undef. Clauses over variables that this solver doesn't map are skipped.
+	void importLearnts(vec<Lit> & store);
+};
+
+}
+;
+#endif /* PORTFOLIO_H_ */
@@ -25,6 +25,7 @@
 
 #include "monosat/mtl/Sort.h"
 #include "monosat/graph/GraphTheory.h"
+#include "monosat/core/Portfolio.h"
 using namespace Monosat;
 
 //=================================================================================================
@@ -35,13 +36,19 @@ using namespace Monosat;
 // Constructor/Destructor:
 
 Solver::Solver() :
+		Solver(SolverConfig()) {
+}
+
+Solver::Solver(const SolverConfig & _config) :
 
 // Parameters (user settable):
 //
-		verbosity(opt_verb), var_decay(opt_var_decay), clause_decay(opt_clause_decay), theory_decay(opt_var_decay), random_var_freq(
-		opt_random_var_freq), random_seed(opt_random_seed), luby_restart(opt_luby_restart), ccmin_mode(
-		opt_ccmin_mode), phase_saving(opt_phase_saving), rnd_pol(false), rnd_init_act(opt_rnd_init_act), garbage_frac(
-		opt_garbage_frac), restart_first(opt_restart_first), restart_inc(opt_restart_inc)
+		config(_config), verbosity(opt_verb), var_decay(opt_var_decay), clause_decay(opt_clause_decay), theory_decay(opt_var_decay), random_var_freq(
+		opt_random_var_freq), random_seed(config.random_seed), luby_restart(opt_luby_restart), ccmin_mode(
+		opt_ccmin_mode), lbd_tiers(opt_lbd_tiers), lbd_core(opt_lbd_core), lbd_tier2(opt_lbd_tier2), phase_saving(opt_phase_saving), rnd_pol(false), rnd_init_act(opt_rnd_init_act), garbage_frac(
+		opt_garbage_frac), restart_first(opt_restart_first), restart_inc(opt_restart_inc), ema_restarts(opt_ema_restarts), ema_restart_margin(
+		opt_ema_restart_margin), ema_restart_min(opt_ema_restart_min), ema_restart_block(opt_ema_restart_block), mode_switch(
+		opt_mode_switch), stable_restart_first(opt_stable_restart_first), target_phase(opt_target_phase), rephase(opt_rephase)
 
 		// Parameters (the rest):
 		//
@@ -75,6 +82,7 @@ Solver::~Solver() {
 	if(pbsolver){
 		delete pbsolver;
 	}
+	delete drat;
 }
 
 //=================================================================================================
@@ -98,6 +106,9 @@ Var Solver::newVar(bool sign, bool dvar) {
 		activity.push();
 		seen.push(0);
 		polarity.push();
+		initial_polarity.push();
+		target_polarity.push();
+		best_polarity.push();
 		decision.push();
 		trail.capacity(v + 1);
 	}
@@ -116,6 +127,9 @@ Var Solver::newVar(bool sign, bool dvar) {
 	activity[v] = (rnd_init_act ? drand(random_seed) * 0.00001 : 0);
 	seen[v] = 0;
 	polarity[v]=opt_init_rnd_phase ? irand(random_seed, 1) : sign;
+	initial_polarity[v]=polarity[v];
+	target_polarity[v]=2;
+	best_polarity[v]=2;
 	//decision.push();//set below
 
 	if (max_decision_var > 0 && v > max_decision_var)
@@ -150,12 +164,17 @@ bool Solver::addClause_(vec<Lit>& ps, bool is_derived_clause) {
 	sort(ps);
 	Lit p;
 	int i, j;
+	bool strengthened = false;
 	for (i = j = 0, p = lit_Undef; i < ps.size(); i++)
 		if (value(ps[i]) == l_True || ps[i] == ~p)
 			return true;
 		else if (value(ps[i]) != l_False && ps[i] != p)
 			ps[j++] = p = ps[i];
+		else if (value(ps[i]) == l_False)
+			strengthened = true;
 	ps.shrink(i - j);
+	if (drat && strengthened)
+		proofAdd(ps);
 
 	if (ps.size() == 0)
 		return ok = false;
@@ -190,6 +209,8 @@ CRef Solver::attachReasonClause(Lit r,vec<Lit> & ps) {
 		fprintf(opt_write_learnt_clauses," 0\n");
 		fflush(opt_write_learnt_clauses);
 	}
+	if (drat)
+		proofAdd(ps, DratWriter::Theory);
 
 	//sort(ps);
 	Lit p;
@@ -373,6 +394,11 @@ void Solver::detachClause(CRef cr, bool strict) {
 
 void Solver::removeClause(CRef cr) {
 	Clause& c = ca[cr];
+	if (drat) {
+		if (decisionLevel() == 0)
+			proofUnits();
+		proofDelete(c);
+	}
 	detachClause(cr);
 	// Don't leave pointers to free'd memory!
 	if (locked(c))
@@ -394,7 +420,7 @@ void Solver::cancelUntil(int lev) {
 	if (decisionLevel() > lev) {
 
 		for (int i = 0; i < theories.size(); i++) {
-			if(opt_lazy_backtrack  && theories[i]->supportsLazyBacktracking()){
+			if(config.lazy_backtrack  && theories[i]->supportsLazyBacktracking()){
 				//if we _are_ backtracking lazily, then the assumption is that the theory solver will, after backtracking, mostly re-assign the same literals.
 				//so instead, we will backtrack the theory lazily, in the future, if it encounters an apparent conflict (and this backtracking may alter or eliminate that conflict.)
 			}else{
@@ -496,7 +522,49 @@ Lit Solver::pickBranchLit() {
 		} else
 			next = order_heap.removeMin();
 
-	return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : polarity[next]);
+	return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : pickPolarity(next));
+}
+
+bool Solver::pickPolarity(Var v) {
+	if (target_phase == 2 || (target_phase == 1 && stable_mode)) {
+		if (target_polarity[v] != 2)
+			return target_polarity[v];
+	}
+	return polarity[v];
+}
+
+void Solver::updateTargetPhases() {
+	//Every level below the conflicting one is conflict free
+	int assigned = trail_lim.last();
+	if (assigned > target_trail) {
+		target_trail = assigned;
+		for (int i = 0; i < assigned; i++)
+			target_polarity[var(trail[i])] = sign(trail[i]);
+	}
+	if (rephase && assigned > best_trail) {
+		best_trail = assigned;
+		for (int i = 0; i < assigned; i++)
+			best_polarity[var(trail[i])] = sign(trail[i]);
+	}
+}
+
+void Solver::rephaseSavedPhases() {
+	//Cycle through best, original, best, inverted phases
+	int kind = rephases++ % 4;
+	for (Var v = 0; v < nVars(); v++) {
+		if (kind % 2 == 0) {
+			if (best_polarity[v] != 2)
+				polarity[v] = best_polarity[v];
+		} else if (kind == 1) {
+			polarity[v] = initial_polarity[v];
+		} else {
+			polarity[v] = !initial_polarity[v];
+		}
+		target_polarity[v] = 2;
+	}
+	target_trail = 0;
+	if (kind % 2 == 0)
+		best_trail = 0;
 }
 
 void Solver::instantiateLazyDecision(Lit p,int atLevel, CRef reason){
@@ -581,8 +649,11 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 			assert(!isTheoryCause(confl));
 			Clause& c = ca[confl];
 
-			if (c.learnt())
+			if (c.learnt()) {
 				claBumpActivity(c);
+				if (lbd_tiers)
+					updateLearntTier(c);
+			}
 
 			for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++) {
 				Lit q = c[j];
@@ -811,9 +882,13 @@ void Solver::enqueueLazy(Lit p, int lev, CRef from){
 	assert(value(p)!=l_False);
 	if(value(p)==l_True && lev < level(var(p))){
 		//then the lit was already implied, but needs to be (lazily) moved to an earlier level.
+		if (drat && lev == 0 && isTheoryCause(from))
+			proofAdd(p, DratWriter::Theory);
 		vardata[var(p)] = mkVarData(from, lev);
 	}else if(value(p)==l_Undef && lev<decisionLevel()){
 		assert(value(p) == l_Undef);
+		if (drat && lev == 0 && isTheoryCause(from))
+			proofAdd(p, DratWriter::Theory);
 		assigns[var(p)] = lbool(!sign(p));
 		vardata[var(p)] = mkVarData(from, lev);
 		trail.push_(p);
@@ -832,6 +907,10 @@ void Solver::enqueueLazy(Lit p, int lev, CRef from){
 
 void Solver::uncheckedEnqueue(Lit p, CRef from) {
 	assert(value(p) == l_Undef);
+	if (drat && decisionLevel() == 0 && isTheoryCause(from)) {
+		//theory propagations at level 0 are never explained by reason clauses, so record them as theory lemmas
+		proofAdd(p, DratWriter::Theory);
+	}
 	assigns[var(p)] = lbool(!sign(p));
 	vardata[var(p)] = mkVarData(from, decisionLevel());
 	trail.push_(p);
@@ -1120,11 +1199,6 @@ CRef Solver::propagate(bool propagate_theories) {
 			}
 			initialPropagate = false;
 		}
-		static int iter = 0;
-		if (++iter == 36) {
-
-			int a = 1;
-		}
 		//printf("iter %d\n",iter);
 		//printf("iter %d\n",iter);
 		//propagate theories;
@@ -1178,6 +1252,7 @@ CRef Solver::propagate(bool propagate_theories) {
  |  Description:
  |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
  |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+ |    If lbd_tiers is set, only the local and theory tiers are reduced (see reduceDBTiered()).
  |________________________________________________________________________________________________@*/
 struct reduceDB_lt {
 	ClauseAllocator& ca;
@@ -1189,6 +1264,10 @@ struct reduceDB_lt {
 	}
 };
 void Solver::reduceDB() {
+	if (lbd_tiers) {
+		reduceDBTiered();
+		return;
+	}
 	int i, j;
 	double extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
 
@@ -1207,6 +1286,147 @@ void Solver::reduceDB() {
 	checkGarbage();
 }
 
+struct reduceDB_lbd_lt {
+	ClauseAllocator& ca;
+	reduceDB_lbd_lt(ClauseAllocator& ca_) :
+			ca(ca_) {
+	}
+	//Orders the clauses to remove first (high LBD, then low activity) to the front
+	bool operator ()(CRef x, CRef y) {
+		if (ca[x].size() == 2 || ca[y].size() == 2)
+			return ca[y].size() == 2 && ca[x].size() > 2;
+		if (ca[x].lbd() != ca[y].lbd())
+			return ca[x].lbd() > ca[y].lbd();
+		return ca[x].activity() < ca[y].activity();
+	}
+};
+
+void Solver::setLearntTier(Clause& c, int lbd, bool from_theory) {
+	c.setLBD(lbd);
+	if (lbd <= lbd_core) {
+		c.setTier(Clause::TIER_CORE);
+		n_core_learnts++;
+	} else if (from_theory) {
+		c.setTier(Clause::TIER_THEORY);
+	} else if (lbd <= lbd_tier2) {
+		c.setTier(Clause::TIER_2);
+	} else {
+		c.setTier(Clause::TIER_LOCAL);
+	}
+}
+
+void Solver::updateLearntTier(Clause& c) {
+	if (c.tier() == Clause::TIER_CORE)
+		return;
+	c.setUsed(true);
+	int lbd = computeLBD(c);
+	if (lbd >= c.lbd())
+		return;
+	c.setLBD(lbd);
+	if (lbd <= lbd_core) {
+		c.setTier(Clause::TIER_CORE);
+		n_core_learnts++;
+		stats_lbd_promotions++;
+	} else if (lbd <= lbd_tier2 && c.tier() == Clause::TIER_LOCAL) {
+		c.setTier(Clause::TIER_2);
+		stats_lbd_promotions++;
+	}
+}
+
+/*_________________________________________________________________________________________________
+ |
+ |  reduceDBTiered : ()  ->  [void]
+ |
+ |  Description:
+ |    Core clauses are always kept. Tier 2 clauses that have not been used in conflict analysis since
+ |    the last reduction are demoted to the local tier. Local clauses and theory clauses (which are
+ |    learnt from theory conflicts, and are expensive to re-derive) that have been used since the last
+ |    reduction, or theory clauses with an LBD within tier 2, are kept; half of the remaining clauses,
+ |    highest LBD and then lowest activity first, are removed.
+ |________________________________________________________________________________________________@*/
+void Solver::reduceDBTiered() {
+	reduce_candidates.clear();
+	n_core_learnts = 0;
+	for (CRef cr : learnts) {
+		Clause& c = ca[cr];
+		switch (c.tier()) {
+		case Clause::TIER_CORE:
+			n_core_learnts++;
+			break;
+		case Clause::TIER_2:
+			if (!c.used())
+				c.setTier(Clause::TIER_LOCAL);
+			break;
+		case Clause::TIER_THEORY:
+			if (!c.used() && c.lbd() > lbd_tier2)
+				reduce_candidates.push(cr);
+			break;
+		case Clause::TIER_LOCAL:
+			if (!c.used())
+				reduce_candidates.push(cr);
+			break;
+		}
+		c.setUsed(false);
+	}
+
+	sort(reduce_candidates, reduceDB_lbd_lt(ca));
+	int limit = reduce_candidates.size() / 2;
+	for (int i = 0; i < limit; i++) {
+		Clause& c = ca[reduce_candidates[i]];
+		if (c.size() > 2 && !locked(c)) {
+			stats_removed_clauses++;
+			removeClause(reduce_candidates[i]);
+		}
+	}
+
+	int i, j;
+	for (i = j = 0; i < learnts.size(); i++) {
+		if (ca[learnts[i]].mark() != 1)
+			learnts[j++] = learnts[i];
+	}
+	learnts.shrink(i - j);
+	checkGarbage();
+}
+
+bool Solver::importSharedLearnts() {
+	assert(decisionLevel() == 0);
+	shared_learnts.clear();
+	portfolio->importLearnts(shared_learnts);
+	int i = 0;
+	while (i < shared_learnts.size()) {
+		shared_clause.clear();
+		bool skip = false;
+		for (; shared_learnts[i] != lit_Undef; i++) {
+			Lit l = shared_learnts[i];
+			if (var(l) >= nVars() || isEliminated(var(l)) || value(l) == l_True) {
+				skip = true;
+			} else if (value(l) == l_Undef) {
+				shared_clause.push(l);
+			}
+		}
+		i++;
+		if (skip)
+			continue;
+		stats_shared_imported++;
+		if (drat) {
+			//learnt by another solver, from whose proof it would follow
+			proofAdd(shared_clause, DratWriter::Theory);
+		}
+		if (shared_clause.size() == 0) {
+			return false;
+		} else if (shared_clause.size() == 1) {
+			uncheckedEnqueue(shared_clause[0]);
+		} else {
+			CRef cr = ca.alloc(shared_clause, true);
+			if (lbd_tiers)
+				setLearntTier(ca[cr], shared_clause.size(), false);
+			learnts.push(cr);
+			attachClause(cr);
+		}
+	}
+	return true;
+}
+
 void Solver::removeSatisfied(vec<CRef>& cs) {
 	int i, j;
 	for (i = j = 0; i < cs.size(); i++) {
@@ -1254,6 +1474,12 @@ bool Solver::simplify() {
 
 	// Remove satisfied clauses:
 	removeSatisfied(learnts);
+	if (lbd_tiers) {
+		n_core_learnts = 0;
+		for (CRef cr : learnts)
+			if (ca[cr].tier() == Clause::TIER_CORE)
+				n_core_learnts++;
+	}
 	if (remove_satisfied){        // Can be turned off.
 		removeSatisfied(clauses);
 
@@ -1263,11 +1489,14 @@ bool Solver::simplify() {
 			seen[released_vars[i]] = 1;
 		}
 
+		if (drat)
+			proofUnits();
 		int i, j;
 		for (i = j = 0; i < trail.size(); i++)
 			if (seen[var(trail[i])] == 0)
 				trail[j++] = trail[i];
 		trail.shrink(i - j);
+		proof_units = trail.size();
 		//printf("trail.size()= %d, qhead = %d\n", trail.size(), qhead);
 		qhead = trail.size();
 
@@ -1397,6 +1626,8 @@ void Solver::addClauseSafely(vec<Lit> & ps) {
 		fprintf(opt_write_learnt_clauses," 0\n");
 		fflush(opt_write_learnt_clauses);
 	}
+	if (drat)
+		proofAdd(ps, DratWriter::Theory);
 
 	if(decisionLevel()==0){
 		addClause_(ps,true);
@@ -1503,10 +1734,6 @@ void Solver::addClauseSafely(vec<Lit> & ps) {
 	}
 }
 bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent) {
-	static int nlearnt=0;
-	if(++nlearnt== 111){
-		int a=1;
-	}
 	if(opt_write_learnt_clauses){
 		if(++opt_n_learnts==47){
 			int a=1;
@@ -1519,6 +1746,8 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 		fprintf(opt_write_learnt_clauses," 0\n");
 		fflush(opt_write_learnt_clauses);
 	}
+	if (drat)
+		proofAdd(ps, DratWriter::Theory);
 	//bool any_undef=false;
 	sort(ps);
 	Lit p;
@@ -1635,6 +1864,8 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 			if (permanent || opt_permanent_theory_conflicts)
 				clauses.push(cr);
 			else {
+				if (lbd_tiers)
+					setLearntTier(ca[cr], computeLBD(ps), true);
 				learnts.push(cr);
 				if (--learntsize_adjust_cnt <= 0) {
 					learntsize_adjust_confl *= learntsize_adjust_inc;
@@ -1705,16 +1936,11 @@ lbool Solver::search(int nof_conflicts) {
 	vec<Lit> learnt_clause;
 	bool last_decision_was_theory=false;
 	starts++;
-	bool using_theory_decisions= opt_decide_theories && drand(random_seed) < opt_random_theory_freq;
-	bool using_theory_vsids= opt_decide_theories && opt_theory_order_vsids && drand(random_seed) < opt_random_theory_vsids_freq;
+	bool using_theory_decisions= config.decide_theories && drand(random_seed) < opt_random_theory_freq;
+	bool using_theory_vsids= config.decide_theories && opt_theory_order_vsids && drand(random_seed) < opt_random_theory_vsids_freq;
 
 	n_theory_decision_rounds+=using_theory_decisions;
 	for (;;) {
-		static int iter = 0;
-		if (++iter ==  268) {
-			int a = 1;
-		}
-
 		propagate: CRef confl = propagate(!disable_theories);
 		conflict: if (!okay() || (confl != CRef_Undef)) {
 			// CONFLICT
@@ -1732,8 +1958,27 @@ lbool Solver::search(int nof_conflicts) {
 			}
 			if (decisionLevel() == 0)
 				return l_False;
+			if (rephase || target_phase == 2 || (target_phase == 1 && stable_mode))
+				updateTargetPhases();
+			int conflict_trail = trail.size();
 			learnt_clause.clear();
 			analyze(confl, learnt_clause, backtrack_level);
+			if (drat)
+				proofAdd(learnt_clause);
+			int lbd = (lbd_tiers || ema_restarts) ? computeLBD(learnt_clause) : 0;
+			if (ema_restarts) {
+				lbd_fast.update(lbd);
+				lbd_slow.update(lbd);
+				trail_average.update(conflict_trail);
+				//Glucose's restart blocking: an unusually long trail suggests the solver may be close to a model
+				if (ema_restart_block > 0 && !stable_mode && conflicts > 10000 && conflictC >= ema_restart_min
+						&& conflict_trail > ema_restart_block * trail_average.value)
+					conflictC = 0;
+			}
+			if (portfolio && learnt_clause.size() <= portfolio->shareSize()) {
+				portfolio->exportLearnt(learnt_clause);
+				stats_shared_exported++;
+			}
 
 			cancelUntil(backtrack_level);
 
@@ -1744,6 +1989,8 @@ lbool Solver::search(int nof_conflicts) {
 				uncheckedEnqueue(learnt_clause[0]);
 			} else {
 				CRef cr = ca.alloc(learnt_clause, true);
+				if (lbd_tiers)
+					setLearntTier(ca[cr], lbd, false);
 				learnts.push(cr);
 				attachClause(cr);
 				claBumpActivity(ca[cr]);
@@ -1818,7 +2065,7 @@ lbool Solver::search(int nof_conflicts) {
 
 
 			// NO CONFLICT
-			if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()) {
+			if (restartDue(conflictC, nof_conflicts) || !withinBudget()) {
 				// Reached bound on number of conflicts:
 				progress_estimate = progressEstimate();
 				cancelUntil(initial_level);
@@ -1829,7 +2076,7 @@ lbool Solver::search(int nof_conflicts) {
 			if (decisionLevel() == 0 && !simplify())
 				return l_False;
 
-			if (learnts.size() - nAssigns() >= max_learnts)
+			if (learnts.size() - n_core_learnts - nAssigns() >= max_learnts)
 				// Reduce the set of learnt clauses:
 				reduceDB();
 			last_decision_was_theory=false;
@@ -1854,7 +2101,7 @@ lbool Solver::search(int nof_conflicts) {
 			//Note: decision level is now added before theories make their decisions, to allow them to decide multiple literals at once.
 			newDecisionLevel();
 
-			if (opt_decide_theories &&!!disable_theories && using_theory_decisions && next == lit_Undef && (opt_theory_conflict_max==0 || conflicts>=next_theory_decision) ) {
+			if (config.decide_theories &&!!disable_theories && using_theory_decisions && next == lit_Undef && (opt_theory_conflict_max==0 || conflicts>=next_theory_decision) ) {
 
 				int next_var_priority=INT_MIN;
 
@@ -2000,6 +2247,39 @@ static double luby(double y, int x) {
 
 	return pow(y, seq);
 }
+
+int Solver::nextRestartLimit(int curr_restarts) {
+	if (mode_switch > 0 && conflicts >= next_mode_switch) {
+		if (mode_switch_interval == 0) {
+			mode_switch_interval = mode_switch;
+		} else {
+			stable_mode = !stable_mode;
+			if (!stable_mode)
+				mode_switch_interval *= 2;
+			target_trail = 0;
+			stats_mode_switches++;
+		}
+		next_mode_switch = conflicts + mode_switch_interval;
+	}
+	if (rephase > 0 && conflicts >= next_rephase) {
+		if (next_rephase > 0)
+			rephaseSavedPhases();
+		//rephase at arithmetically increasing intervals
+		next_rephase = conflicts + (uint64_t) rephase * (rephases + 1);
+	}
+	if (stable_mode)
+		return luby(2, stable_restarts++) * stable_restart_first;
+	if (ema_restarts)
+		return -1;
+	double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
+	return rest_base * restart_first;
+}
+
+bool Solver::restartDue(int conflictC, int nof_conflicts) {
+	if (nof_conflicts >= 0)
+		return conflictC >= nof_conflicts;
+	return ema_restarts && conflictC >= ema_restart_min && lbd_fast.value > ema_restart_margin * lbd_slow.value;
+}
 bool Solver::propagateAssignment(const vec<Lit> & assumps){
 	only_propagate_assumptions=true;
 	budgetOff();
@@ -2015,8 +2295,11 @@ lbool Solver::solve_() {
 	clearInterrupt();
 	model.clear();
 	conflict.clear();
-	if (!ok)
+	if (!ok) {
+		if (drat)
+			proofFinish(l_False);
 		return l_False;
+	}
 
 	if(pbsolver){
 		pbsolver->convert();
@@ -2050,19 +2333,31 @@ lbool Solver::solve_() {
 	// Search:
 	int curr_restarts = 0;
 	while (status == l_Undef) {
-		double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
+		int restart_limit = nextRestartLimit(curr_restarts);
+		if (portfolio) {
+			//another solver of the portfolio may have finished before this solver's interrupt flag was cleared, above
+			if (portfolio->cancelled())
+				break;
+			if (curr_restarts > 0 && !importSharedLearnts()) {
+				status = l_False;
+				break;
+			}
+		}
 
 		if (opt_rnd_phase) {
 			for (int i = 0; i < nVars(); i++)
 				polarity[i] = irand(random_seed, 1);
 		}
-		if(opt_decide_theories && opt_randomomize_theory_order){
+		if(config.decide_theories && opt_randomomize_theory_order){
 			randomShuffle(random_seed, decidable_theories);
 		}
 
-		status = search(rest_base * restart_first);
+		status = search(restart_limit);
 		if (!withinBudget()) {
-
+			if (portfolio && portfolio->cancelled()) {
+				//another worker of the portfolio already finished
+				break;
+			}
 			printf("Solver is giving up due to budget constraints: ");
 			if(conflict_budget >= 0 && conflicts >= conflict_budget){
 				printf("too many conflicts ");
@@ -2150,11 +2445,27 @@ lbool Solver::solve_() {
 	} else if (status == l_False) {
 		assert(ok);
 	}
+	if (drat)
+		proofFinish(status);
 
 	assumptions.clear();
 	return status;
 }
 
+void Solver::proofUnits() {
+	assert(decisionLevel() == 0);
+	for (; proof_units < trail.size(); proof_units++)
+		proofAdd(trail[proof_units]);
+}
+
+void Solver::proofFinish(lbool status) {
+	if (status == l_False) {
+		//the final conflict is the empty clause, or (if the assumptions are unsatisfiable) the clause of negated assumptions
+		proofAdd(conflict);
+	}
+	drat->flush();
+}
+
 bool Solver::solveTheory(vec<Lit> & conflict_out) {
 	initial_level = decisionLevel();
 	track_min_level = initial_level;
@@ -33,7 +33,9 @@
 #include "monosat/core/Theory.h"
 #include "monosat/core/TheorySolver.h"
 #include "monosat/core/Config.h"
+#include "monosat/core/DratProof.h"
 #include <cinttypes>
+#include <atomic>
 
 //this is _really_ ugly...
 template<unsigned int D, class T> class GeometryTheorySolver;
@@ -43,6 +45,7 @@ template<typename Weight> class GraphTheorySolver;
 class FSMTheorySolver;
 
 class DimacsMap;
+class PortfolioMember;
 //=================================================================================================
 // Solver -- the main class:
 // The MiniSAT Boolean SAT solver, extended to provided basic SMT support.
@@ -63,6 +66,7 @@ public:
 	// Constructor/Destructor:
 	//
 	Solver();
+	Solver(const SolverConfig & config);
 	virtual ~Solver();
 
 	// Problem specification:
@@ -186,9 +190,22 @@ public:
 		printf("restarts              : %" PRIu64 "\n", starts);
 		printf("conflicts             : %-12" PRIu64 "   (%.0f /sec, %d learnts (%ld theory learnts), %" PRId64 " removed)\n", conflicts,
 			   conflicts / cpu_time, learnts.size(),stats_theory_conflicts, stats_removed_clauses);
+		if(lbd_tiers){
+			int tiers[4] = {0,0,0,0};
+			for (CRef cr : learnts)
+				tiers[ca[cr].tier()]++;
+			printf("learnt clause tiers   : %d core, %d tier2, %d local, %d theory (%ld promotions)\n", tiers[Clause::TIER_CORE],
+				   tiers[Clause::TIER_2], tiers[Clause::TIER_LOCAL], tiers[Clause::TIER_THEORY], stats_lbd_promotions);
+		}
+		if(stats_mode_switches || rephases){
+			printf("restart modes         : %ld mode switches, %d rephases\n", stats_mode_switches, rephases);
+		}
+		if(stats_shared_exported || stats_shared_imported){
+			printf("portfolio clauses     : %ld exported, %ld imported\n", stats_shared_exported, stats_shared_imported);
+		}
 		printf("decisions             : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", decisions,
 			   (float) rnd_decisions * 100 / (float) decisions, decisions / cpu_time);
-		if(opt_decide_theories){
+		if(config.decide_theories){
 			printf("Theory decisions: %ld\n",stats_theory_decisions);
 			printf("Theory decision rounds: %" PRId64 "/%" PRId64 "\n",n_theory_decision_rounds,starts);
 		}
@@ -312,10 +329,6 @@ public:
 
 	//Lazily construct a reason for a literal propagated from a theory
 	CRef constructReason(Lit p) {
-		static int iterp =0;
-		if(++iterp==45){
-			int a=1;
-		}
 		assert(value(p)==l_True);
 		CRef cr = reason(var(p));
 		assert(isTheoryCause(cr));
@@ -338,7 +351,7 @@ public:
 #endif
 #ifdef DEBUG_SOLVER
 		//assert all the other reasons in this cause are earlier on the trail than p...
-		static vec<bool> marks;
+		static thread_local vec<bool> marks;
 		marks.clear();
 		marks.growTo(nVars());
 		for(int i = 0;i<trail.size() && var(trail[i])!=var(p);i++) {
@@ -438,6 +451,9 @@ public:
 	bool isDecisionVar(Var v){
 		return decision[v];
 	}
+	virtual bool isEliminated(Var v) const{
+		return false;
+	}
 	// Read state:
 	//
 	lbool value(Var x) const;       // The current value of a variable.
@@ -461,6 +477,18 @@ public:
 	void interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
 	void clearInterrupt();     // Clear interrupt indicator flag.
 
+	//If set, this solver is one of a portfolio of solvers working on the same problem (see Portfolio.h):
+	//it gives up at the next restart once another solver of the portfolio has finished, and exchanges short learnt clauses with the others.
+	PortfolioMember * portfolio=nullptr;
+
+	//If set, every clause this solver learns, derives or deletes is written to this proof (see DratProof.h), which the solver owns.
+	DratWriter * drat=nullptr;
+	int proof_units=0;//the level 0 literals of the trail before this position have been recorded in the proof
+	void setProofWriter(DratWriter * writer){
+		delete drat;
+		drat=writer;
+	}
+
 	// Memory managment:
 	//
 	virtual void garbageCollect();
@@ -523,6 +551,7 @@ public:
 	DimacsMap * varRemap=nullptr;
 	// Mode of operation:
 	//
+	SolverConfig config; // Algorithm selections and propagation settings, shared with the theories of this solver.
 	bool printed_header = false;
 	int verbosity;
 	double var_decay;
@@ -531,6 +560,9 @@ public:
 	double random_seed;
 	bool luby_restart;
 	int ccmin_mode;         // Controls conflict clause minimization (0=none, 1=basic, 2=deep).
+	bool lbd_tiers;         // Manage learnt clauses in tiers by LBD (see reduceDB()).
+	int lbd_core;           // Learnt clauses with at most this LBD are never reduced.
+	int lbd_tier2;          // Learnt clauses with at most this LBD are kept while they remain in use.
 	int phase_saving;       // Controls the level of phase saving (0=none, 1=limited, 2=full).
 	bool rnd_pol;            // Use random polarities for branching heuristics.
 	bool rnd_init_act;       // Initialize variable activities with a small random value.
@@ -538,6 +570,14 @@ public:
 
 	int restart_first; // The initial restart limit.                                                                (default 100)
 	double restart_inc; // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
+	bool ema_restarts;         // In focused mode, restart when the fast moving average of learnt clause LBDs exceeds the slow one.
+	double ema_restart_margin; // ... by this factor,
+	int ema_restart_min;       // ... at most once per this many conflicts,
+	double ema_restart_block;  // ... unless the trail is this factor longer than its average (0 = never block restarts).
+	int mode_switch;           // Conflicts before the first switch between focused and stable mode (0 = stay in focused mode).
+	int stable_restart_first;  // The base of the Luby restart sequence in stable mode.
+	int target_phase;          // When to decide the target phase (0=never, 1=in stable mode, 2=always).
+	int rephase;               // Conflicts between resets of the saved phases (0 = never).
 	double learntsize_factor; // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
 	double learntsize_inc; // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
 
@@ -551,6 +591,10 @@ public:
 			pure_literal_detections, stats_removed_clauses;
 	uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
 	long stats_theory_conflicts =0;
+	long stats_lbd_promotions=0;
+	long stats_shared_exported=0;
+	long stats_shared_imported=0;
+	long stats_mode_switches=0;
 	long stats_solver_preempted_decisions=0;
 	long stats_theory_decisions=0;
 	double stats_pure_lit_time=0;
@@ -667,6 +711,9 @@ protected:
 	int theoryConflict=-1;
 	vec<lbool> assigns;          // The current assignments.
 	vec<char> polarity;         // The preferred polarity of each variable.
+	vec<char> initial_polarity; // The polarity of each variable before any phase saving.
+	vec<char> target_polarity;  // The polarity of each variable in the largest conflict-free assignment since the last rephase (2 if unassigned in it).
+	vec<char> best_polarity;    // The polarity of each variable in the largest conflict-free assignment found so far (2 if unassigned in it).
 	vec<char> decision;         // Declares if a variable is eligible for selection in the decision heuristic.
 	vec<int> priority;		  // Static, lexicographic heuristic. Larger values are higher priority (decided first)
 	vec<TheoryData> theory_vars;
@@ -701,10 +748,47 @@ protected:
 	vec<Lit> analyze_stack;
 	vec<Lit> analyze_toclear;
 	vec<Lit> add_tmp;
+	vec<uint64_t> lbd_stamp;  //lbd_stamp[level]==lbd_counter iff the level has been counted by the current computeLBD()
+	uint64_t lbd_counter=0;
+	vec<CRef> reduce_candidates;
+	vec<Lit> shared_learnts;
+	vec<Lit> shared_clause;
 
 	vec<vec<Lit>> clauses_to_add;
 
+	//Exponential moving average, with the bias towards its initial value of 0 corrected for (as in CaDiCaL).
+	struct EMA {
+		double alpha;
+		double value=0;
+		double biased=0;
+		double beta=1;
+		EMA(double alpha) :
+				alpha(alpha) {
+		}
+		void update(double y) {
+			biased += alpha * (y - biased);
+			if (beta > 1e-10) {
+				beta *= 1 - alpha;
+				value = biased / (1 - beta);
+			} else {
+				value = biased;
+			}
+		}
+	};
+	EMA lbd_fast{1.0 / 32};
+	EMA lbd_slow{1.0 / 4096};
+	EMA trail_average{1.0 / 5000};
+	bool stable_mode=false;
+	uint64_t next_mode_switch=0;
+	uint64_t mode_switch_interval=0;
+	int stable_restarts=0;
+	int target_trail=0; //number of assigned literals in the target assignment
+	int best_trail=0;
+	uint64_t next_rephase=0;
+	int rephases=0;
+
 	double max_learnts=1;
+	int n_core_learnts=0; //core tier learnt clauses are not counted against max_learnts
 	double learntsize_adjust_confl=0;
 	int learntsize_adjust_cnt=0;
 
@@ -712,12 +796,17 @@ protected:
 	//
 	int64_t conflict_budget;    // -1 means no budget.
 	int64_t propagation_budget; // -1 means no budget.
-	bool asynch_interrupt=false;
+	std::atomic<bool> asynch_interrupt{false}; //may be set from other threads, or from a signal handler
 
 	// Main internal methods:
 	//
 	void insertVarOrder(Var x);                               // Insert a variable in the decision order priority queue.
 	Lit pickBranchLit();                                                      // Return the next decision variable.
+	bool pickPolarity(Var v);                                                 // Return the polarity to decide 'v' with.
+	void updateTargetPhases();                                                // Record the conflict-free part of the trail as the target (and best) phases, if it is the largest yet.
+	void rephaseSavedPhases();                                                // Reset the saved phases, cycling between the best, original and inverted phases.
+	int nextRestartLimit(int curr_restarts);                                  // Switch modes or rephase, if due, and return the conflict limit for the next search() (-1 if restarts are decided by LBD).
+	bool restartDue(int conflictC, int nof_conflicts);                        // Whether search() should restart after 'conflictC' conflicts.
 public:
 	void instantiateLazyDecision(Lit l, int atLevel, CRef reason);
 	Lit theoryDecisionLit(int theoryID){
@@ -745,6 +834,9 @@ public:
 	double & getRandomSeed()override{
 		return random_seed;
 	}
+	const SolverConfig & getConfig()override{
+		return config;
+	}
 
 
 
@@ -796,7 +888,13 @@ protected:
 	lbool search(int nof_conflicts);                                     // Search for a given number of conflicts.
 	lbool solve_();                                           // Main solve method (assumptions given in 'assumptions').
 	void reduceDB();                                                      // Reduce the set of learnt clauses.
+	void reduceDBTiered();                                 // Reduce the local and theory tiers of the learnt clauses.
+	template<class Lits>
+	int computeLBD(const Lits& lits);             // Number of distinct decision levels among the assigned literals.
+	void setLearntTier(Clause& c, int lbd, bool from_theory);    // Assign a newly learnt clause to its tier.
+	void updateLearntTier(Clause& c); // Recompute the LBD of a learnt clause used in conflict analysis, promoting it if it improved.
 	void removeSatisfied(vec<CRef>& cs);                           // Shrink 'cs' to contain only non-satisfied clauses.
+	bool importSharedLearnts();         // Add the learnt clauses shared by the rest of the portfolio (at level 0). FALSE if this made the solver UNSAT.
 	void rebuildOrderHeap();
 	void rebuildTheoryOrderHeap();
 	// Maintaining Variable/Clause activity:
@@ -852,6 +950,32 @@ protected:
 	bool satisfied(const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
 	void relocAll(ClauseAllocator& to);
+
+	// Proof logging (only called if 'drat' is set):
+	//
+	//Record a clause in the proof (excluding the literal 'skip', if given), as a learnt clause or as a theory lemma.
+	template<class Lits>
+	void proofAdd(const Lits & ps, char step = DratWriter::Add, Lit skip = lit_Undef) {
+		drat->begin(step);
+		for (int i = 0; i < ps.size(); i++)
+			if (ps[i] != skip)
+				drat->lit(unmap(ps[i]));
+		drat->end();
+	}
+	void proofAdd(Lit p, char step = DratWriter::Add) {
+		drat->begin(step);
+		drat->lit(unmap(p));
+		drat->end();
+	}
+	template<class Lits>
+	void proofDelete(const Lits & ps) {
+		drat->begin(DratWriter::Delete);
+		for (int i = 0; i < ps.size(); i++)
+			drat->lit(unmap(ps[i]));
+		drat->end();
+	}
+	void proofUnits();               // Record any new level 0 literals, so that the clauses that implied them can be deleted.
+	void proofFinish(lbool status);  // Record the final conflict (if 'status' is l_False) and flush the proof.
 public:
 	// Misc:
 	//
@@ -1025,6 +1149,24 @@ inline void Solver::claBumpActivity(Clause& c) {
 	}
 }
 
+template<class Lits>
+inline int Solver::computeLBD(const Lits& lits) {
+	lbd_counter++;
+	int lbd = 0;
+	for (Lit l : lits) {
+		if (value(l) == l_Undef)
+			continue;
+		int lev = level(var(l));
+		if (lbd_stamp.size() <= lev)
+			lbd_stamp.growTo(lev + 1, 0);
+		if (lbd_stamp[lev] != lbd_counter) {
+			lbd_stamp[lev] = lbd_counter;
+			lbd++;
+		}
+	}
+	return lbd;
+}
+
 inline void Solver::checkGarbage(void) {
 	return checkGarbage(garbage_frac);
 }
@@ -1122,6 +1264,7 @@ inline bool Solver::hasNextDecision()const{
 }
 inline void Solver::setPolarity(Var v, bool b) {
 	polarity[v] = b;
+	initial_polarity[v] = b;
 }
 inline void Solver::setDecisionVar(Var v, bool b) {
 	if (b && !decision[v])
@@ -0,0 +1,70 @@
+/****************************************************************************************[SolverConfig.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef SOLVERCONFIG_H_
+#define SOLVERCONFIG_H_
+
+#include "monosat/core/Config.h"
+
+namespace Monosat {
+
+/**
+ * The algorithm selections and propagation settings of one solver (and of the theories attached to it).
+ *
+ * A default constructed SolverConfig is a snapshot of the current global options (see Config.h), and
+ * every Solver takes such a snapshot when it is constructed. Later changes to the global options
+ * (for example, by parsing the arguments of another solver in newSolver_args()) therefore do not
+ * affect solvers that already exist, and differently configured solvers can be run side by side by
+ * constructing each from its own SolverConfig.
+ */
+struct SolverConfig {
+	ReachAlg reach_alg;
+	ConnectivityAlg undirected_alg;
+	AllPairsAlg allpairs_alg;
+	AllPairsConnectivityAlg undirected_allpairs_alg;
+	MinCutAlg mincut_alg;
+	MinSpanAlg mst_alg;
+	ComponentsAlg components_alg;
+	CycleAlg cycle_alg;
+	DistAlg dist_alg;
+
+	bool lazy_backtrack;
+	bool decide_theories;
+	double random_seed;
+	int graph_prop_skip;
+	int bv_prop_skip;
+	int fsm_prop_skip;
+	int parallel_detectors;
+	bool graph_csr;
+
+	SolverConfig() :
+			reach_alg(reachalg), undirected_alg(undirectedalg), allpairs_alg(allpairsalg), undirected_allpairs_alg(
+					undirected_allpairsalg), mincut_alg(mincutalg), mst_alg(mstalg), components_alg(componentsalg), cycle_alg(
+					cyclealg), dist_alg(distalg), lazy_backtrack(opt_lazy_backtrack), decide_theories(
+						opt_decide_theories), random_seed(opt_random_seed), graph_prop_skip(opt_graph_prop_skip), bv_prop_skip(
+					opt_bv_prop_skip), fsm_prop_skip(opt_fsm_prop_skip), parallel_detectors(opt_parallel_detectors), graph_csr(
+					opt_graph_csr) {
+	}
+};
+
+}
+;
+#endif /* SOLVERCONFIG_H_ */
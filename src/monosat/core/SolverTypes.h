@@ -185,6 +185,9 @@ class Clause {
 		unsigned reloced :1;
 		unsigned derived :1;
 		unsigned size :26;
+		unsigned lbd :29;
+		unsigned tier :2;
+		unsigned used :1;
 	} header;
 	union {
 		Lit lit;
@@ -204,6 +207,9 @@ class Clause {
 		header.reloced = 0;
 		header.size = ps.size();
 		header.derived = 0;
+		header.lbd = 0;
+		header.tier = TIER_LOCAL;
+		header.used = 0;
 
 		for (int i = 0; i < ps.size(); i++)
 			data[i].lit = ps[i];
@@ -217,6 +223,14 @@ class Clause {
 	}
 
 public:
+	//The tiers that learnt clauses are sorted into by Solver::reduceDB(), based on their LBD ('glue')
+	enum Tier {
+		TIER_CORE = 0, //never removed (except when satisfied at level 0)
+		TIER_2 = 1, //kept for as long as they keep taking part in conflict analysis
+		TIER_LOCAL = 2, //reduced by LBD and activity
+		TIER_THEORY = 3 //learnt from theory conflicts
+	};
+
 	void calcAbstraction() {
 		assert(header.has_extra);
 		uint32_t abstraction = 0;
@@ -268,6 +282,27 @@ public:
 		header.derived = t;
 	}
 
+	//Literal block distance: the number of distinct decision levels among the clause's literals, when last computed
+	uint32_t lbd() const {
+		return header.lbd;
+	}
+	void setLBD(uint32_t lbd) {
+		header.lbd = lbd;
+	}
+	Tier tier() const {
+		return (Tier) header.tier;
+	}
+	void setTier(Tier t) {
+		header.tier = t;
+	}
+	//True if the clause has taken part in conflict analysis since the last reduceDB()
+	bool used() const {
+		return header.used;
+	}
+	void setUsed(bool u) {
+		header.used = u;
+	}
+
 	bool reloced() const {
 		return header.reloced;
 	}
@@ -400,6 +435,9 @@ public:
 		// Copy extra data-fields:
 		// (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
 		to[cr].mark(c.mark());
+		to[cr].setLBD(c.lbd());
+		to[cr].setTier(c.tier());
+		to[cr].setUsed(c.used());
 		if (to[cr].learnt())
 			to[cr].activity() = c.activity();
 		else if (to[cr].has_extra())
@@ -23,6 +23,7 @@
 #define THEORYSOLVER_H_
 #include "monosat/core/SolverTypes.h"
 #include "monosat/pb/Pb.h"
+#include "monosat/core/SolverConfig.h"
 
 namespace Monosat {
 /**
@@ -34,6 +35,7 @@ public:
 		
 	}
 	virtual double & getRandomSeed()=0;
+	virtual const SolverConfig & getConfig()=0;
 	virtual void addTheory(Theory * t)=0;
 	virtual lbool value(Lit l)const=0;
 	virtual lbool value(Var v)const=0;
@@ -433,8 +433,6 @@ public:
 		return num_updates;
 	}
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.modifications == last_modification) {
 			stats_skipped_updates++;
@@ -779,8 +777,6 @@ public:
 	}
 	
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.modifications == last_modification) {
 			stats_skipped_updates++;
@@ -112,8 +112,6 @@ public:
 		return num_updates;
 	}
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.modifications == last_modification)
 			return;
@@ -395,8 +393,6 @@ public:
 		return num_updates;
 	}
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.modifications == last_modification)
 			return;
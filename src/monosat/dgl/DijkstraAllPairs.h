@@ -122,8 +122,6 @@ public:
 		return num_updates;
 	}
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 		stats_full_updates++;
 		
 		if (last_modification > 0 && g.modifications == last_modification) {
@@ -114,10 +114,8 @@ public:
 	void dbg_print_graph(int from, int to) {
 #ifndef NDEBUG
 		return;
-		static int it = 0;
-		if (++it == 6) {
-			int a = 1;
-		}
+		static thread_local int it = 0;
+		it++;
 		printf("Graph %d\n", it);
 		printf("digraph{\n");
 		for (int i = 0; i < g.nodes(); i++) {
@@ -97,8 +97,6 @@ public:
 	}
 	
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.modifications == last_modification) {
 			stats_skipped_updates++;
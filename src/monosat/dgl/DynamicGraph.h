@@ -54,7 +54,8 @@ public:
 template<typename Weight>
 class DynamicGraph {
 	
-	std::vector<bool> edge_status;
+	//one byte per edge (rather than std::vector<bool>), so that checking an edge's status doesn't require extracting a bit
+	std::vector<char> edge_status;
 	std::vector<bool> edge_status_const;
 	std::vector<Weight> weights;
 	int num_nodes=0;
@@ -86,6 +87,16 @@ public:
 	std::vector<std::vector<Edge> > adjacency_list;
 	std::vector<std::vector<Edge> > inverted_adjacency_list;
 	std::vector<std::vector<Edge> > adjacency_undirected_list;
+private:
+	//Compressed sparse row copies of the three adjacency lists, built by freeze().
+	//The edges of node n are csr_*_edges[csr_*_start[n]] ... csr_*_edges[csr_*_start[n+1]-1].
+	bool frozen=false;
+	std::vector<int> csr_out_start;
+	std::vector<Edge> csr_out_edges;
+	std::vector<int> csr_in_start;
+	std::vector<Edge> csr_in_edges;
+	std::vector<int> csr_undirected_start;
+	std::vector<Edge> csr_undirected_edges;
 public:
 	struct FullEdge {
 		int from;
@@ -164,7 +175,7 @@ public:
 	}
 	
 	int addNode() {
-		
+		frozen=false;
 		adjacency_list.push_back( { }); //adj list
 		adjacency_undirected_list.push_back( { });
 		inverted_adjacency_list.push_back( { });
@@ -217,6 +228,7 @@ public:
 		}
 		
 		num_edges = next_id;
+		frozen=false;
 		adjacency_list[from].push_back( { to, id });
 		adjacency_undirected_list[from].push_back( { to, id });
 		adjacency_undirected_list[to].push_back( { from, id });
@@ -265,9 +277,34 @@ public:
 		return num_edges;
 	}
 	
+	/**
+	 * Copy the adjacency lists into flat, contiguous (compressed sparse row) arrays, which nIncident(), incident(),
+	 * nIncoming() and incoming() will read from until the next node or edge is added.
+	 * Call this once all nodes and edges have been declared; edges can still be enabled and disabled afterward.
+	 */
+	void freeze(){
+		if(frozen)
+			return;
+		buildCSR(adjacency_list,csr_out_start,csr_out_edges);
+		buildCSR(inverted_adjacency_list,csr_in_start,csr_in_edges);
+		buildCSR(adjacency_undirected_list,csr_undirected_start,csr_undirected_edges);
+		frozen=true;
+	}
+
+	bool isFrozen()const{
+		return frozen;
+	}
+
 	inline int nIncident(int node, bool undirected = false) {
 		assert(node >= 0);
 		assert(node < nodes());
+		if(frozen){
+			if (undirected) {
+				return csr_undirected_start[node+1]-csr_undirected_start[node];
+			} else {
+				return csr_out_start[node+1]-csr_out_start[node];
+			}
+		}
 		if (undirected) {
 			return adjacency_undirected_list[node].size();
 		} else {
@@ -295,6 +332,13 @@ public:
 	inline int nIncoming(int node, bool undirected = false) {
 		assert(node >= 0);
 		assert(node < nodes());
+		if(frozen){
+			if (undirected) {
+				return csr_undirected_start[node+1]-csr_undirected_start[node];
+			} else {
+				return csr_in_start[node+1]-csr_in_start[node];
+			}
+		}
 		if (undirected) {
 			return adjacency_undirected_list[node].size();
 		} else {
@@ -306,6 +350,13 @@ public:
 		assert(node >= 0);
 		assert(node < nodes());
 		assert(i < nIncident(node, undirected));
+		if(frozen){
+			if (undirected) {
+				return csr_undirected_edges[csr_undirected_start[node]+i];
+			} else {
+				return csr_out_edges[csr_out_start[node]+i];
+			}
+		}
 		if (undirected) {
 			return adjacency_undirected_list[node][i];
 		} else {
@@ -316,6 +367,13 @@ public:
 		assert(node >= 0);
 		assert(node < nodes());
 		assert(i < nIncoming(node, undirected));
+		if(frozen){
+			if (undirected) {
+				return csr_undirected_edges[csr_undirected_start[node]+i];
+			} else {
+				return csr_in_edges[csr_in_start[node]+i];
+			}
+		}
 		if (undirected) {
 			return adjacency_undirected_list[node][i];
 		} else {
@@ -652,6 +710,7 @@ public:
 	}
 
 	void clear(){
+		frozen=false;
 		edge_status.clear();
 		num_nodes=0;
 		num_edges=0;
@@ -678,10 +737,21 @@ public:
 		to.adjacency_undirected_list=adjacency_undirected_list;
 		to.all_edges =all_edges;
 		to.inverted_adjacency_list=inverted_adjacency_list;
-
-
+		if(frozen)
+			to.freeze();
+	}
+private:
+	static void buildCSR(const std::vector<std::vector<Edge> > & lists, std::vector<int> & start, std::vector<Edge> & edges){
+		start.clear();
+		edges.clear();
+		start.reserve(lists.size()+1);
+		start.push_back(0);
+		for(const std::vector<Edge> & list:lists){
+			edges.insert(edges.end(),list.begin(),list.end());
+			start.push_back(edges.size());
+		}
+		edges.shrink_to_fit();
 	}
-
 };
 
 }
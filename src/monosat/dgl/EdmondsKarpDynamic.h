@@ -193,10 +193,6 @@ public:
 		int s = source;
 		int t = sink;
 		//see http://cstheory.stackexchange.com/a/10186
-		static int it = 0;
-		if (++it == 56) {
-			int a = 1;
-		}
 
 		if (g.outfile) {
 			fprintf(g.outfile, "f %d %d\n", s, t);
@@ -629,10 +625,8 @@ private:
 	void dbg_print_graph(int from, int to, Weight shortCircuitFrom = -1, Weight shortCircuitTo = -1) {
 #ifndef NDEBUG
 		return;
-		static int it = 0;
-		if (++it == 6) {
-			int a = 1;
-		}
+		static thread_local int it = 0;
+		it++;
 		printf("Graph %d\n", it);
 		printf("digraph{\n");
 		for (int i = 0; i < g.nodes(); i++) {
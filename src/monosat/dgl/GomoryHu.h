@@ -0,0 +1,277 @@
+/****************************************************************************************[GomoryHu.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef GOMORY_HU_H
+#define GOMORY_HU_H
+
+#include "DynamicGraph.h"
+#include "PushRelabel.h"
+#include <vector>
+#include <cstdio>
+
+namespace dgl {
+
+/**
+ * A Gomory-Hu cut tree over a set of terminal nodes, built with Gusfield's method, which needs one maximum flow
+ * computation per terminal (rather than one per pair of terminals).
+ *
+ * Cut trees only exist for undirected graphs, so the tree is built with every edge of g made undirected.
+ * Its cuts are used as a pool of cuts between the terminals: the capacity of each cut in g (in both directions)
+ * is kept up to date as edges are enabled, disabled or re-weighted, so any cut that separates s from t gives an
+ * upper bound on the maximum s-t flow in g, even after the tree itself has become stale.
+ * The tree is rebuilt once it has answered as many queries as it has terminals, and the graph has changed since;
+ * each time a tree is replaced without any of its bounds having been used (see markUseful()), that interval doubles.
+ */
+template<typename Weight>
+class GomoryHuTree: public DynamicGraphAlgorithm {
+public:
+	DynamicGraph<Weight> & g;
+	//g, with each edge in both directions (edges 2*i and 2*i+1 are edge i of g)
+	DynamicGraph<Weight> sym;
+	PushRelabel<Weight> flow;
+
+	std::vector<int> terminals;
+	std::vector<int> terminal_index;
+	//parent[i] is the parent of terminal i in the tree (terminal 0 is the root), and tree_flow[i] the maximum flow
+	//between terminal i and its parent, in the undirected graph.
+	std::vector<int> parent;
+	std::vector<Weight> tree_flow;
+	//side[i] holds the nodes on terminal i's side of the cut between terminal i and its parent
+	std::vector<std::vector<bool>> side;
+	//total weight of the enabled edges of g leaving, and entering, side[i]
+	std::vector<Weight> out_capacity;
+	std::vector<Weight> in_capacity;
+	//weight of each edge of g as of the last update (0 if the edge is disabled)
+	std::vector<Weight> local_weight;
+
+	bool needs_rebuild = true;
+	int built_nodes = -1;
+	int last_build_modification = -1;
+	int queries_since_build = 0;
+	int rebuild_interval = 0;
+	bool useful_since_build = false;
+
+	int last_modification = -1;
+	int history_qhead = 0;
+	int last_history_clear = -1;
+	int alg_id;
+
+	long stats_builds = 0;
+	long stats_maxflows = 0;
+	long stats_queries = 0;
+
+	GomoryHuTree(DynamicGraph<Weight> & g) :
+			g(g), flow(sym) {
+		alg_id = g.addDynamicAlgorithm(this);
+	}
+
+	void addTerminal(int node) {
+		if (terminal_index.size() <= node)
+			terminal_index.resize(node + 1, -1);
+		if (terminal_index[node] >= 0)
+			return;
+		terminal_index[node] = terminals.size();
+		terminals.push_back(node);
+		needs_rebuild = true;
+	}
+
+	//Record that a bound from the current tree was used (to decide a literal or to explain a conflict).
+	void markUseful() {
+		useful_since_build = true;
+	}
+
+	void updateHistory() {
+		update();
+	}
+
+	void printStats() {
+		printf("Gomory-Hu tree (%d terminals): builds %ld, maxflows %ld, queries %ld\n", (int) terminals.size(),
+				stats_builds, stats_maxflows, stats_queries);
+	}
+
+	//Bring the capacities of the cuts up to date with g.
+	void update() {
+		if (last_modification > 0 && g.modifications == last_modification)
+			return;
+		bool full_scan = last_modification <= 0 || g.historyclears != last_history_clear || g.changed();
+		if (local_weight.size() != g.edges()) {
+			local_weight.resize(g.edges(), 0);
+			full_scan = true;
+		}
+		if (g.nodes() != built_nodes)
+			needs_rebuild = true;
+		if (full_scan) {
+			for (int edgeID = 0; edgeID < g.edges(); edgeID++)
+				setWeight(edgeID);
+		} else {
+			for (int i = history_qhead; i < g.historySize(); i++)
+				setWeight(g.getChange(i).id);
+		}
+		last_modification = g.modifications;
+		history_qhead = g.historySize();
+		g.updateAlgorithmHistory(this, alg_id, history_qhead);
+		last_history_clear = g.historyclears;
+	}
+
+	/**
+	 * Find the cut of least capacity (in g, in the direction from s to t) among the cuts of the tree that separate s from t.
+	 * Returns false if no cut separates them; otherwise, bound is an upper bound on the maximum s-t flow in g,
+	 * and cut identifies the cut for getCutEdges().
+	 */
+	bool upperBound(int s, int t, Weight & bound, int & cut) {
+		stats_queries++;
+		update();
+		if (needs_rebuild || (g.modifications != last_build_modification && queries_since_build >= rebuild_interval))
+			rebuild();
+		queries_since_build++;
+		cut = -1;
+		for (int i = 1; i < side.size(); i++) {
+			if (side[i][s] == side[i][t])
+				continue;
+			const Weight & c = side[i][s] ? out_capacity[i] : in_capacity[i];
+			if (cut < 0 || c < bound) {
+				bound = c;
+				cut = i;
+			}
+		}
+		return cut >= 0;
+	}
+
+	//Collect the edges of g (enabled or not) that cross the cut from the side that contains node s.
+	void getCutEdges(int cut, int s, std::vector<int> & edges) {
+		edges.clear();
+		std::vector<bool> & in_side = side[cut];
+		bool s_side = in_side[s];
+		for (int u = 0; u < g.nodes(); u++) {
+			if (in_side[u] != s_side)
+				continue;
+			for (int i = 0; i < g.nIncident(u); i++) {
+				if (in_side[g.incident(u, i).node] != s_side)
+					edges.push_back(g.incident(u, i).id);
+			}
+		}
+	}
+
+private:
+
+	void setWeight(int edgeID) {
+		Weight w = 0;
+		if (g.hasEdge(edgeID) && g.edgeEnabled(edgeID) && !g.selfLoop(edgeID))
+			w = g.getWeight(edgeID);
+		if (w == local_weight[edgeID])
+			return;
+		Weight delta = w - local_weight[edgeID];
+		local_weight[edgeID] = w;
+		if (needs_rebuild)
+			return; //all of the capacities will be recomputed
+		int from = g.getEdge(edgeID).from;
+		int to = g.getEdge(edgeID).to;
+		for (int i = 1; i < side.size(); i++) {
+			if (side[i][from] && !side[i][to])
+				out_capacity[i] += delta;
+			else if (!side[i][from] && side[i][to])
+				in_capacity[i] += delta;
+		}
+	}
+
+	void rebuild() {
+		stats_builds++;
+		if (needs_rebuild || useful_since_build || rebuild_interval < terminals.size())
+			rebuild_interval = terminals.size();
+		else if (rebuild_interval < (1 << 24))
+			rebuild_interval *= 2;
+		useful_since_build = false;
+		needs_rebuild = false;
+		built_nodes = g.nodes();
+		last_build_modification = g.modifications;
+		queries_since_build = 0;
+		while (sym.nodes() < g.nodes())
+			sym.addNode();
+		while (sym.edges() < 2 * g.edges()) {
+			int edgeID = sym.edges() / 2;
+			int from = g.getEdge(edgeID).from;
+			int to = g.getEdge(edgeID).to;
+			sym.enableEdge(sym.addEdge(from, to, -1, 0));
+			sym.enableEdge(sym.addEdge(to, from, -1, 0));
+		}
+		for (int edgeID = 0; edgeID < g.edges(); edgeID++) {
+			sym.setEdgeWeight(2 * edgeID, local_weight[edgeID]);
+			sym.setEdgeWeight(2 * edgeID + 1, local_weight[edgeID]);
+		}
+
+		int n_terminals = terminals.size();
+		parent.clear();
+		parent.resize(n_terminals, 0);
+		if (n_terminals > 0)
+			parent[0] = -1;
+		tree_flow.clear();
+		tree_flow.resize(n_terminals, 0);
+		side.resize(n_terminals);
+		for (int s = 1; s < n_terminals; s++) {
+			int t = parent[s];
+			flow.setSource(terminals[s]);
+			flow.setSink(terminals[t]);
+			Weight f = flow.minCut(cut);
+			stats_maxflows++;
+			side[s].clear();
+			side[s].resize(g.nodes());
+			for (int u = 0; u < g.nodes(); u++)
+				side[s][u] = flow.inSourcePartition(u);
+			tree_flow[s] = f;
+			for (int i = 1; i < n_terminals; i++) {
+				if (i != s && parent[i] == t && side[s][terminals[i]])
+					parent[i] = s;
+			}
+			if (parent[t] >= 0 && side[s][terminals[parent[t]]]) {
+				//s takes t's place in the tree
+				parent[s] = parent[t];
+				parent[t] = s;
+				tree_flow[s] = tree_flow[t];
+				tree_flow[t] = f;
+				std::swap(side[s], side[t]);
+				side[t].flip();
+			}
+		}
+		sym.clearChanged();
+		sym.clearHistory(true);
+
+		out_capacity.clear();
+		out_capacity.resize(n_terminals, 0);
+		in_capacity.clear();
+		in_capacity.resize(n_terminals, 0);
+		for (int edgeID = 0; edgeID < g.edges(); edgeID++) {
+			if (local_weight[edgeID] == 0)
+				continue;
+			int from = g.getEdge(edgeID).from;
+			int to = g.getEdge(edgeID).to;
+			for (int i = 1; i < n_terminals; i++) {
+				if (side[i][from] && !side[i][to])
+					out_capacity[i] += local_weight[edgeID];
+				else if (!side[i][from] && side[i][to])
+					in_capacity[i] += local_weight[edgeID];
+			}
+		}
+	}
+	std::vector<MaxFlowEdge> cut;
+};
+}
+;
+#endif
@@ -0,0 +1,393 @@
+/****************************************************************************************[IncrementalAllPairs.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef INCREMENTAL_ALLPAIRS_H_
+#define INCREMENTAL_ALLPAIRS_H_
+
+#include <vector>
+#include <algorithm>
+#include "monosat/dgl/alg/Heap.h"
+#include "DynamicGraph.h"
+#include "AllPairs.h"
+
+namespace dgl {
+
+/**
+ * Maintains a shortest path tree (in number of edges, as FloydWarshall and DijkstraAllPairs do) from each source,
+ * and repairs those trees from the graph's edge history rather than recomputing them after each change.
+ *
+ * Deleted edges are handled as in Ramalingam and Reps' algorithm: the nodes whose tree edge was removed are
+ * examined in order of their old distance, and are only 'affected' if no unaffected node can still reach them
+ * at the same distance; new distances are then found for the affected nodes alone.
+ * Added edges seed a (Dijkstra) relaxation from their heads, which only visits nodes whose distance decreases.
+ * Either way, the cost of an update depends on the part of each tree that changed, rather than on the size of the graph.
+ */
+template<typename Weight, class Status = AllPairs::NullStatus>
+class IncrementalAllPairs: public AllPairs, public DynamicGraphAlgorithm {
+public:
+
+	DynamicGraph<Weight> & g;
+	Status & status;
+	int last_modification;
+	int last_addition;
+	int last_deletion;
+	int history_qhead;
+
+	int last_history_clear;
+	int alg_id;
+
+	std::vector<int> sources;
+	//source_index[u] is the position of u in sources, or -1
+	std::vector<int> source_index;
+	int INF;
+
+	const int reportPolarity;
+
+	//dist[i][u] is the length of the shortest path from sources[i] to u, and prev_edge[i][u] the last edge of that path (or -1)
+	std::vector<std::vector<int> > dist;
+	std::vector<std::vector<int> > prev_edge;
+
+	std::vector<int> added_edges;
+	std::vector<int> removed_edges;
+	//candidates for becoming unreachable at their current distance, bucketed by that distance
+	std::vector<std::vector<int> > buckets;
+	std::vector<char> affected;
+	std::vector<int> affected_nodes;
+
+	std::vector<int> * dist_ptr = nullptr;
+	struct DistCmp {
+		std::vector<int> ** _dist;
+		bool operator()(int a, int b) const {
+			return (**_dist)[a] < (**_dist)[b];
+		}
+		DistCmp(std::vector<int> **d) :
+				_dist(d) {
+		}
+		;
+	};
+
+	Heap<DistCmp> q;
+
+public:
+	int stats_full_updates;
+	int stats_fast_updates;
+	int stats_skipped_updates;
+	int stats_affected_nodes;
+	double mod_percentage;
+
+	IncrementalAllPairs(DynamicGraph<Weight> & graph, Status & _status = AllPairs::nullStatus, int _reportPolarity = 0) :
+			g(graph), status(_status), last_modification(-1), last_addition(-1), last_deletion(-1), history_qhead(0), last_history_clear(
+					0), INF(0), reportPolarity(_reportPolarity), q(DistCmp(&dist_ptr)) {
+		//if more edges than this fraction of the graph changed since the last update, recompute from scratch
+		mod_percentage = 0.2;
+		stats_full_updates = 0;
+		stats_fast_updates = 0;
+		stats_skipped_updates = 0;
+		stats_affected_nodes = 0;
+		alg_id = g.addDynamicAlgorithm(this);
+	}
+
+	void addSource(int s) {
+		assert(!std::count(sources.begin(), sources.end(), s));
+		if (source_index.size() <= s)
+			source_index.resize(s + 1, -1);
+		source_index[s] = sources.size();
+		sources.push_back(s);
+		dist.push_back(std::vector<int>());
+		prev_edge.push_back(std::vector<int>());
+
+		last_modification = -1;
+		last_addition = -1;
+		last_deletion = -1;
+	}
+
+	long num_updates = 0;
+	int numUpdates() const {
+		return num_updates;
+	}
+
+	void updateHistory() {
+		update();
+	}
+
+	void update() {
+		if (last_modification > 0 && g.modifications == last_modification) {
+			stats_skipped_updates++;
+			return;
+		}
+
+		if (last_modification <= 0 || g.changed() || last_history_clear != g.historyclears || INF != g.nodes() + 1
+				|| g.historySize() - history_qhead > mod_percentage * g.edges()) {
+			fullUpdate();
+		} else {
+			stats_fast_updates++;
+			added_edges.clear();
+			removed_edges.clear();
+			for (int i = history_qhead; i < g.historySize(); i++) {
+				int edgeid = g.getChange(i).id;
+				if (g.getChange(i).addition && g.edgeEnabled(edgeid)) {
+					added_edges.push_back(edgeid);
+				} else if (g.getChange(i).deletion && !g.edgeEnabled(edgeid)) {
+					removed_edges.push_back(edgeid);
+				}
+			}
+			if (added_edges.size() || removed_edges.size()) {
+				for (int i = 0; i < sources.size(); i++) {
+					updateSource(i);
+				}
+			}
+		}
+
+		for (int i = 0; i < sources.size(); i++) {
+			int s = sources[i];
+			for (int u = 0; u < g.nodes(); u++) {
+				if (dist[i][u] >= INF && reportPolarity < 1) {
+					status.setReachable(s, u, false);
+					status.setMininumDistance(s, u, false, INF);
+				} else if (dist[i][u] < INF && reportPolarity > -1) {
+					status.setReachable(s, u, true);
+					status.setMininumDistance(s, u, true, dist[i][u]);
+				}
+			}
+		}
+		assert(dbg_uptodate());
+		num_updates++;
+		last_modification = g.modifications;
+		last_deletion = g.deletions;
+		last_addition = g.additions;
+
+		g.updateAlgorithmHistory(this, alg_id, history_qhead);
+		history_qhead = g.historySize();
+		last_history_clear = g.historyclears;
+	}
+
+private:
+	void fullUpdate() {
+		stats_full_updates++;
+		INF = g.nodes() + 1;
+		affected.clear();
+		affected.resize(g.nodes(), false);
+		buckets.resize(INF);
+		for (int i = 0; i < sources.size(); i++) {
+			std::vector<int> & d = dist[i];
+			std::vector<int> & prev = prev_edge[i];
+			d.clear();
+			d.resize(g.nodes(), INF);
+			prev.clear();
+			prev.resize(g.nodes(), -1);
+			//breadth first search, using affected_nodes as the queue
+			affected_nodes.clear();
+			int s = sources[i];
+			d[s] = 0;
+			affected_nodes.push_back(s);
+			for (int j = 0; j < affected_nodes.size(); j++) {
+				int u = affected_nodes[j];
+				for (int k = 0; k < g.nIncident(u); k++) {
+					int edgeid = g.incident(u, k).id;
+					int v = g.incident(u, k).node;
+					if (g.edgeEnabled(edgeid) && d[v] == INF) {
+						d[v] = d[u] + 1;
+						prev[v] = edgeid;
+						affected_nodes.push_back(v);
+					}
+				}
+			}
+		}
+		affected_nodes.clear();
+	}
+
+	void relax(std::vector<int> & d, std::vector<int> & prev, int v, int distance, int edgeid) {
+		if (distance < d[v]) {
+			d[v] = distance;
+			prev[v] = edgeid;
+			if (!q.inHeap(v))
+				q.insert(v);
+			else
+				q.decrease(v);
+		}
+	}
+
+	void updateSource(int i) {
+		std::vector<int> & d = dist[i];
+		std::vector<int> & prev = prev_edge[i];
+		dist_ptr = &d;
+		q.clear();
+
+		//Find the nodes that can no longer be reached by a path of the same length.
+		//These are examined in order of distance, so that a node's possible predecessors are all settled before it is.
+		int max_bucket = 0;
+		for (int edgeid : removed_edges) {
+			int v = g.getEdge(edgeid).to;
+			if (prev[v] == edgeid) {
+				buckets[d[v]].push_back(v);
+				max_bucket = std::max(max_bucket, d[v]);
+			}
+		}
+		for (int b = 1; b <= max_bucket; b++) {
+			for (int j = 0; j < buckets[b].size(); j++) {
+				int w = buckets[b][j];
+				if (affected[w] || d[w] != b)
+					continue;
+				bool supported = false;
+				for (int k = 0; k < g.nIncoming(w); k++) {
+					int edgeid = g.incoming(w, k).id;
+					int x = g.incoming(w, k).node;
+					if (g.edgeEnabled(edgeid) && !affected[x] && d[x] + 1 == b) {
+						prev[w] = edgeid;
+						supported = true;
+						break;
+					}
+				}
+				if (!supported) {
+					affected[w] = true;
+					affected_nodes.push_back(w);
+					//every child of w in the shortest path tree must now be examined, too
+					for (int k = 0; k < g.nIncident(w); k++) {
+						int edgeid = g.incident(w, k).id;
+						int y = g.incident(w, k).node;
+						if (prev[y] == edgeid && b + 1 < INF) {
+							buckets[b + 1].push_back(y);
+							max_bucket = std::max(max_bucket, b + 1);
+						}
+					}
+				}
+			}
+			buckets[b].clear();
+		}
+		stats_affected_nodes += affected_nodes.size();
+
+		//Each affected node starts from its best remaining unaffected predecessor
+		for (int w : affected_nodes) {
+			d[w] = INF;
+			prev[w] = -1;
+		}
+		for (int w : affected_nodes) {
+			for (int k = 0; k < g.nIncoming(w); k++) {
+				int edgeid = g.incoming(w, k).id;
+				int x = g.incoming(w, k).node;
+				if (g.edgeEnabled(edgeid) && !affected[x] && d[x] < INF) {
+					relax(d, prev, w, d[x] + 1, edgeid);
+				}
+			}
+		}
+		for (int w : affected_nodes)
+			affected[w] = false;
+		affected_nodes.clear();
+
+		//Added edges can only shorten paths
+		for (int edgeid : added_edges) {
+			int u = g.getEdge(edgeid).from;
+			int v = g.getEdge(edgeid).to;
+			if (g.edgeEnabled(edgeid) && d[u] < INF) {
+				relax(d, prev, v, d[u] + 1, edgeid);
+			}
+		}
+
+		while (q.size()) {
+			int u = q.removeMin();
+			for (int k = 0; k < g.nIncident(u); k++) {
+				int edgeid = g.incident(u, k).id;
+				if (g.edgeEnabled(edgeid)) {
+					relax(d, prev, g.incident(u, k).node, d[u] + 1, edgeid);
+				}
+			}
+		}
+	}
+
+public:
+	//Stores the nodes on a shortest path from 'from' to 'to' (inclusive) in path
+	void getPath(int from, int to, std::vector<int> & path) {
+		update();
+		assert(connected_unsafe(from, to));
+		const std::vector<int> & prev = prev_edge[source_index[from]];
+		path.clear();
+		path.push_back(to);
+		while (prev[to] != -1) {
+			to = g.getEdge(prev[to]).from;
+			path.push_back(to);
+		}
+		std::reverse(path.begin(), path.end());
+	}
+
+	bool dbg_uptodate() {
+#ifdef DEBUG_DGL
+		for (int i = 0; i < sources.size(); i++) {
+			//compare against a breadth first search
+			std::vector<int> expect(g.nodes(), INF);
+			std::vector<int> queue;
+			expect[sources[i]] = 0;
+			queue.push_back(sources[i]);
+			for (int j = 0; j < queue.size(); j++) {
+				int u = queue[j];
+				for (int k = 0; k < g.nIncident(u); k++) {
+					int v = g.incident(u, k).node;
+					if (g.edgeEnabled(g.incident(u, k).id) && expect[v] == INF) {
+						expect[v] = expect[u] + 1;
+						queue.push_back(v);
+					}
+				}
+			}
+			for (int u = 0; u < g.nodes(); u++) {
+				if (expect[u] != dist[i][u])
+					return false;
+				if (u != sources[i] && dist[i][u] < INF) {
+					int e = prev_edge[i][u];
+					if (e < 0 || !g.edgeEnabled(e) || g.getEdge(e).to != u || dist[i][g.getEdge(e).from] + 1 != dist[i][u])
+						return false;
+				}
+			}
+		}
+#endif
+		return true;
+	}
+
+	bool connected_unsafe(int from, int t) {
+		assert(from < source_index.size() && source_index[from] >= 0);
+		return t < dist[source_index[from]].size() && dist[source_index[from]][t] < INF;
+	}
+	bool connected_unchecked(int from, int t) {
+		assert(last_modification == g.modifications);
+		return connected_unsafe(from, t);
+	}
+	bool connected(int from, int t) {
+		if (last_modification != g.modifications)
+			update();
+
+		assert(dbg_uptodate());
+
+		return connected_unsafe(from, t);
+	}
+	int distance(int from, int t) {
+		if (connected(from, t))
+			return dist[source_index[from]][t];
+		else
+			return INF;
+	}
+	int distance_unsafe(int from, int t) {
+		if (connected_unsafe(from, t))
+			return dist[source_index[from]][t];
+		else
+			return INF;
+	}
+};
+}
+;
+#endif
@@ -532,10 +532,6 @@ public:
 		if(same_source_sink)
 			return INF;
 		//see http://cstheory.stackexchange.com/a/10186
-		static int it = 0;
-		if (++it == 95) {
-			int a = 1;
-		}
 
 		if (g.outfile) {
 			fprintf(g.outfile, "f %d %d\n", s, t);
@@ -717,10 +713,8 @@ private:
 
 		if (edge_enabled.size() < g.edges())
 			return;
-		static int it = 0;
-		if (++it == 6) {
-			int a = 1;
-		}
+		static thread_local int it = 0;
+		it++;
 		printf("Graph %d\n", it);
 		printf("digraph{\n");
 		for (int i = 0; i < g.nodes(); i++) {
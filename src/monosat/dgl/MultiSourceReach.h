@@ -0,0 +1,301 @@
+/****************************************************************************************[MultiSourceReach.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef MULTISOURCEREACH_H_
+#define MULTISOURCEREACH_H_
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include "DynamicGraph.h"
+#include "Reach.h"
+namespace dgl {
+
+/**
+ * Bit-parallel reachability from many sources at once.
+ * Each node stores one 64-bit word per group of 64 sources, with bit i of a word set if the i'th source of that group
+ * reaches the node.
+ * Each update makes a single (iterative) Tarjan traversal over the nodes reachable from any source, and then ORs the
+ * words of each strongly connected component into its successors in topological order, so every edge is visited
+ * once per group of 64 sources, rather than once per source.
+ * One instance is shared between all the reachability detectors of a graph; each detector views its own source
+ * through a MultiSourceReachability (below).
+ */
+template<typename Weight>
+class MultiSourceReach {
+public:
+	DynamicGraph<Weight> & g;
+	std::vector<int> sources;
+	int n = 0;
+	int groups = 0;
+	//reach[u*groups + group] holds the reachability of u from the sources of that group
+	std::vector<uint64_t> reach;
+
+	//Tarjan's SCC state
+	struct Frame {
+		int u;
+		int k;
+	};
+	std::vector<Frame> dfs_stack;
+	std::vector<int> scc_stack;
+	std::vector<int> index;
+	std::vector<int> lowlink;
+	std::vector<char> on_stack;
+	std::vector<int> component;
+	//the members of each component, in the order they were completed (which is reverse topological order)
+	std::vector<int> component_nodes;
+	std::vector<int> component_start;
+
+	int last_modification = -1;
+	int last_n_sources = 0;
+	int num_updates = 0;
+	//update() may be reached concurrently from detectors that are updated in parallel
+	std::mutex update_lock;
+
+	int stats_full_updates = 0;
+	int stats_skipped_updates = 0;
+
+	MultiSourceReach(DynamicGraph<Weight> & graph) :
+			g(graph) {
+	}
+
+	/**
+	 * Returns the index of source s, adding it if it is not already tracked.
+	 */
+	int addSource(int s) {
+		for (int i = 0; i < sources.size(); i++) {
+			if (sources[i] == s)
+				return i;
+		}
+		sources.push_back(s);
+		return sources.size() - 1;
+	}
+
+	int numUpdates() const {
+		return num_updates;
+	}
+
+	void update() {
+		std::lock_guard<std::mutex> guard(update_lock);
+		if (last_modification > 0 && g.modifications == last_modification && n == g.nodes()
+				&& last_n_sources == sources.size()) {
+			stats_skipped_updates++;
+			return;
+		}
+		stats_full_updates++;
+		n = g.nodes();
+		groups = (sources.size() + 63) / 64;
+		reach.assign(n * groups, 0);
+		for (int i = 0; i < sources.size(); i++) {
+			reach[sources[i] * groups + (i >> 6)] |= ((uint64_t) 1) << (i & 63);
+		}
+
+		findComponents();
+
+		//components were completed in reverse topological order, so visit them back to front
+		for (int c = component_start.size() - 2; c >= 0; c--) {
+			int begin = component_start[c];
+			int end = component_start[c + 1];
+			for (int group = 0; group < groups; group++) {
+				uint64_t bits = 0;
+				for (int i = begin; i < end; i++)
+					bits |= reach[component_nodes[i] * groups + group];
+				if (!bits)
+					continue;
+				for (int i = begin; i < end; i++) {
+					int u = component_nodes[i];
+					reach[u * groups + group] = bits;
+					for (int k = 0; k < g.nIncident(u); k++) {
+						auto & edge = g.incident(u, k);
+						if (g.edgeEnabled(edge.id) && component[edge.node] != c)
+							reach[edge.node * groups + group] |= bits;
+					}
+				}
+			}
+		}
+
+		num_updates++;
+		last_modification = g.modifications;
+		last_n_sources = sources.size();
+	}
+
+	inline bool connected(int sourceIndex, int t) const {
+		assert(sourceIndex < last_n_sources);
+		return t < n && ((reach[t * groups + (sourceIndex >> 6)] >> (sourceIndex & 63)) & 1);
+	}
+
+	bool uptodate() const {
+		return last_modification == g.modifications && n == g.nodes() && last_n_sources == sources.size();
+	}
+
+private:
+	//Iterative Tarjan's algorithm over the enabled edges, restricted to the nodes reachable from the sources.
+	void findComponents() {
+		index.assign(n, -1);
+		lowlink.resize(n);
+		on_stack.assign(n, 0);
+		component.assign(n, -1);
+		component_nodes.clear();
+		component_start.clear();
+		component_start.push_back(0);
+		scc_stack.clear();
+		int next_index = 0;
+		for (int s : sources) {
+			if (s >= n || index[s] >= 0)
+				continue;
+			dfs_stack.push_back( { s, 0 });
+			index[s] = lowlink[s] = next_index++;
+			scc_stack.push_back(s);
+			on_stack[s] = 1;
+			while (dfs_stack.size()) {
+				Frame & f = dfs_stack.back();
+				int u = f.u;
+				if (f.k < g.nIncident(u)) {
+					auto & edge = g.incident(u, f.k++);
+					if (!g.edgeEnabled(edge.id))
+						continue;
+					int v = edge.node;
+					if (index[v] < 0) {
+						index[v] = lowlink[v] = next_index++;
+						scc_stack.push_back(v);
+						on_stack[v] = 1;
+						dfs_stack.push_back( { v, 0 });
+					} else if (on_stack[v] && index[v] < lowlink[u]) {
+						lowlink[u] = index[v];
+					}
+				} else {
+					dfs_stack.pop_back();
+					if (lowlink[u] == index[u]) {
+						int c = component_start.size() - 1;
+						int w;
+						do {
+							w = scc_stack.back();
+							scc_stack.pop_back();
+							on_stack[w] = 0;
+							component[w] = c;
+							component_nodes.push_back(w);
+						} while (w != u);
+						component_start.push_back(component_nodes.size());
+					}
+					if (dfs_stack.size()) {
+						int parent = dfs_stack.back().u;
+						if (lowlink[u] < lowlink[parent])
+							lowlink[parent] = lowlink[u];
+					}
+				}
+			}
+		}
+	}
+};
+
+/**
+ * Reachability from a single source, computed by a shared MultiSourceReach.
+ * Paths are not tracked, so previous() and incomingEdge() are unsupported; detectors that need paths must pair
+ * this with a separate path detector.
+ */
+template<typename Weight, class Status = Reach::NullStatus>
+class MultiSourceReachability: public Reach {
+public:
+	MultiSourceReach<Weight> & shared;
+	Status & status;
+	int source;
+	int sourceIndex;
+	const int reportPolarity;
+	int last_shared_update = -1;
+	int num_updates = 0;
+	//If non-empty, only these nodes are reported to the status (all nodes can still be queried)
+	std::vector<int> targets;
+
+	MultiSourceReachability(int s, MultiSourceReach<Weight> & _shared, Status & _status = Reach::nullStatus,
+			int _reportPolarity = 0) :
+			shared(_shared), status(_status), source(s), reportPolarity(_reportPolarity) {
+		sourceIndex = shared.addSource(s);
+	}
+
+	void setSource(int s) {
+		source = s;
+		sourceIndex = shared.addSource(s);
+		last_shared_update = -1;
+	}
+	int getSource() {
+		return source;
+	}
+	int numUpdates() const {
+		return num_updates;
+	}
+
+	void addTarget(int node) {
+		targets.push_back(node);
+		last_shared_update = -1;
+	}
+
+	void update() {
+		shared.update();
+		if (last_shared_update == shared.numUpdates())
+			return;
+		last_shared_update = shared.numUpdates();
+		if (targets.size()) {
+			for (int u : targets) {
+				if (u < shared.n)
+					report(u);
+			}
+		} else {
+			for (int u = 0; u < shared.n; u++) {
+				report(u);
+			}
+		}
+		num_updates++;
+	}
+
+	bool connected_unsafe(int t) {
+		return shared.connected(sourceIndex, t);
+	}
+	bool connected_unchecked(int t) {
+		assert(shared.uptodate());
+		return connected_unsafe(t);
+	}
+	bool connected(int t) {
+		if (!shared.uptodate() || last_shared_update != shared.numUpdates())
+			update();
+		return shared.connected(sourceIndex, t);
+	}
+private:
+	inline void report(int u) {
+		bool reached = shared.connected(sourceIndex, u);
+		if (reached && reportPolarity >= 0) {
+			status.setReachable(u, true);
+		} else if (!reached && reportPolarity <= 0) {
+			status.setReachable(u, false);
+		}
+	}
+public:
+	int previous(int node) {
+		assert(false);
+		return -1;
+	}
+	int incomingEdge(int node) {
+		assert(false);
+		return -1;
+	}
+};
+}
+;
+#endif /* MULTISOURCEREACH_H_ */
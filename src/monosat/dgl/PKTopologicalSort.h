@@ -478,7 +478,7 @@ private:
 			return;
 		}
 		//assert ords are unique
-		static std::vector<bool> seen;
+		static thread_local std::vector<bool> seen;
 		seen.clear();
 		seen.resize(g.nodes());
 		for(int i = 0;i<ord.size();i++){
@@ -504,8 +504,6 @@ private:
 
 public:
 	void update() {
-		static int iteration = 0;
-
 
 		if (last_modification > 0 && g.modifications == last_modification) {
 			stats_skipped_updates++;
@@ -513,10 +511,6 @@ public:
 			return;
 		}
 		//g.drawFull();
-		int local_it = ++iteration;//7
-		if(local_it==5){
-			int a=1;
-		}
 		if(last_modification<=0 || g.historyclears != last_history_clear  || g.changed()){
 			setNodes(g.nodes());
 			cycleComputed=false;
@@ -0,0 +1,607 @@
+/****************************************************************************************[PushRelabel.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PUSH_RELABEL_H
+#define PUSH_RELABEL_H
+
+#include "DynamicGraph.h"
+#include "MaxFlow.h"
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+namespace dgl {
+
+/**
+ * Highest-label push-relabel maximum flow (Goldberg and Tarjan), with the gap and global relabeling heuristics
+ * of Cherkassky and Goldberg.
+ *
+ * The flow is kept from one update to the next, and the graph's edge history is used to find the edges whose
+ * capacity changed. Enabling an edge (or increasing its capacity) leaves the old flow feasible, so only the
+ * additional flow has to be pushed. Disabling an edge (or decreasing its capacity below its flow) clips the flow
+ * on that edge, and the resulting imbalance is repaired by cancelling flow along paths out of the edge's head,
+ * before pushing again.
+ */
+template<typename Weight = int>
+class PushRelabel: public MaxFlow<Weight>, public DynamicGraphAlgorithm {
+public:
+	DynamicGraph<Weight> & g;
+	int source = -1;
+	int sink = -1;
+	Weight INF;
+
+	//flow and capacity of each edge (the capacity of disabled edges and self loops is 0)
+	std::vector<Weight> F;
+	std::vector<Weight> C;
+	std::vector<Weight> excess;
+	std::vector<int> label;
+	std::vector<int> pos; //current arc of each node, in its combined forward and backward adjacency list.
+	//nodes with positive excess and a label below nodes(), bucketed by label
+	std::vector<std::vector<int>> active;
+	std::vector<int> label_count;
+	int max_active = -1;
+	int relabels_since_global = 0;
+	//non-terminal nodes that may have negative excess, after the capacity of one of their incoming edges was reduced
+	std::vector<int> deficits;
+
+	//used when cancelling flow
+	std::vector<int> path_nodes;
+	std::vector<int> path_edges;
+	std::vector<int> path_index;
+	std::vector<int> walk_pos;
+	std::vector<int> walked;
+
+	std::vector<bool> changed;
+	std::vector<int> changed_edges;
+	std::vector<int> Q;
+	std::vector<bool> seen;
+
+	Weight curflow = 0;
+	int last_modification = -1;
+	int last_deletion = -1;
+	int last_addition = -1;
+	int history_qhead = 0;
+	int last_history_clear = -1;
+	int alg_id;
+	bool flow_needs_reset = false;
+
+	long num_updates = 0;
+	long stats_pushes = 0;
+	long stats_relabels = 0;
+	long stats_global_relabels = 0;
+	long stats_gaps = 0;
+	long stats_cancelled_paths = 0;
+	long stats_reinits = 0;
+
+	PushRelabel(DynamicGraph<Weight> & _g, int source = -1, int sink = -1) :
+			g(_g), source(source), sink(sink), INF(0xF0F0F0) {
+		alg_id = g.addDynamicAlgorithm(this);
+	}
+
+	int getSource() const {
+		return source;
+	}
+	int getSink() const {
+		return sink;
+	}
+	void setSource(int s) {
+		if (source == s) {
+			return;
+		}
+		source = s;
+		flow_needs_reset = true;
+		last_modification = g.modifications - 1;
+	}
+	void setSink(int t) {
+		if (sink == t) {
+			return;
+		}
+		sink = t;
+		flow_needs_reset = true;
+		last_modification = g.modifications - 1;
+	}
+	int numUpdates() const {
+		return num_updates;
+	}
+	void updateHistory() {
+		update();
+	}
+	void printStats() {
+		printf("Push-Relabel:\n");
+		printf("Pushes: %ld, Relabels: %ld, Global Relabels: %ld, Gaps: %ld, Cancelled Paths: %ld, Reinits: %ld\n",
+				stats_pushes, stats_relabels, stats_global_relabels, stats_gaps, stats_cancelled_paths, stats_reinits);
+	}
+
+	const Weight update() {
+		if (g.outfile) {
+			fprintf(g.outfile, "f %d %d\n", source, sink);
+			fflush(g.outfile);
+		}
+		if (last_modification > 0 && g.modifications == last_modification) {
+			return curflow;
+		}
+		if (source == sink) {
+			curflow = INF;
+			finishUpdate();
+			return curflow;
+		}
+
+		bool full_scan = last_modification <= 0 || g.historyclears != last_history_clear || g.changed();
+		if (F.size() != g.edges() || label.size() != g.nodes()) {
+			//nodes and edges are only ever added, so the existing flow remains valid
+			F.resize(g.edges(), 0);
+			C.resize(g.edges(), 0);
+			excess.resize(g.nodes(), 0);
+			label.resize(g.nodes(), 0);
+			pos.resize(g.nodes(), 0);
+			active.resize(g.nodes());
+			label_count.resize(g.nodes() + 1);
+			path_index.resize(g.nodes(), -1);
+			walk_pos.resize(g.nodes(), 0);
+			full_scan = true;
+		}
+		changed.resize(g.nEdgeIDs());
+		if (flow_needs_reset) {
+			flow_needs_reset = false;
+			stats_reinits++;
+			for (int edgeID = 0; edgeID < F.size(); edgeID++) {
+				if (F[edgeID] != 0) {
+					F[edgeID] = 0;
+					markChanged(edgeID);
+				}
+			}
+			std::fill(excess.begin(), excess.end(), 0);
+		}
+		if (full_scan) {
+			for (int edgeID = 0; edgeID < g.edges(); edgeID++) {
+				setCapacity(edgeID);
+			}
+		} else {
+			for (int i = history_qhead; i < g.historySize(); i++) {
+				setCapacity(g.getChange(i).id);
+			}
+		}
+		for (int u : deficits) {
+			if (excess[u] < 0)
+				cancelFlow(u, -excess[u], true);
+		}
+		deficits.clear();
+
+		globalRelabel();
+		while (true) {
+			while (max_active >= 0 && active[max_active].empty())
+				max_active--;
+			if (max_active < 0)
+				break;
+			int u = active[max_active].back();
+			active[max_active].pop_back();
+			if (excess[u] <= 0 || label[u] != max_active)
+				continue; //stale entry
+			discharge(u);
+			if (relabels_since_global >= g.nodes())
+				globalRelabel();
+		}
+		//the remaining excess cannot reach the sink; return it to the source
+		for (int u = 0; u < g.nodes(); u++) {
+			if (u != source && u != sink && excess[u] > 0)
+				cancelFlow(u, excess[u], false);
+		}
+
+		curflow = 0;
+		for (int i = 0; i < g.nIncoming(sink); i++)
+			curflow += F[g.incoming(sink, i).id];
+		for (int i = 0; i < g.nIncident(sink); i++)
+			curflow -= F[g.incident(sink, i).id];
+		dbg_check_flow();
+		num_updates++;
+		finishUpdate();
+		return curflow;
+	}
+
+	std::vector<int> & getChangedEdges() {
+		return changed_edges;
+	}
+	void clearChangedEdges() {
+		for (int edgeID : changed_edges) {
+			assert(changed[edgeID]);
+			changed[edgeID] = false;
+		}
+		changed_edges.clear();
+	}
+
+	const Weight minCut(std::vector<MaxFlowEdge> & cut) {
+		const Weight f = update();
+		cut.clear();
+		if (source == sink)
+			return f;
+		if (g.outfile) {
+			fprintf(g.outfile, "m %d %d\n", source, sink);
+			fflush(g.outfile);
+		}
+		//the nodes reachable from the source in the residual graph
+		Q.clear();
+		Q.push_back(source);
+		seen.clear();
+		seen.resize(g.nodes());
+		seen[source] = true;
+		for (int j = 0; j < Q.size(); j++) {
+			int u = Q[j];
+			for (int i = 0; i < g.nIncident(u); i++) {
+				int id = g.incident(u, i).id;
+				int v = g.incident(u, i).node;
+				if (!g.edgeEnabled(id))
+					continue;
+				if (C[id] - F[id] == 0) {
+					cut.push_back(MaxFlowEdge { u, v, id }); //potential element of the cut
+				} else if (!seen[v]) {
+					Q.push_back(v);
+					seen[v] = true;
+				}
+			}
+			for (int i = 0; i < g.nIncoming(u); i++) {
+				int id = g.incoming(u, i).id;
+				int v = g.incoming(u, i).node;
+				if (F[id] != 0 && !seen[v]) {
+					Q.push_back(v);
+					seen[v] = true;
+				}
+			}
+		}
+		//Now keep only the edges from a seen vertex to an unseen vertex
+		int i, j = 0;
+		for (i = 0; i < cut.size(); i++) {
+			if (!seen[cut[i].v] && seen[cut[i].u]) {
+				cut[j++] = cut[i];
+			}
+		}
+		cut.resize(j);
+#ifndef NDEBUG
+		assert(!seen[sink]);
+		Weight dbg_sum = 0;
+		for (int i = 0; i < cut.size(); i++) {
+			int id = cut[i].id;
+			assert(F[id] == g.getWeight(id));
+			dbg_sum += F[id];
+		}
+		assert(dbg_sum == f);
+#endif
+		return f;
+	}
+
+	//True if node is on the source side of the cut found by the last call to minCut()
+	const bool inSourcePartition(int node) {
+		return node < seen.size() && seen[node];
+	}
+
+	const Weight getEdgeCapacity(int id) {
+		assert(g.edgeEnabled(id));
+		return g.getWeight(id);
+	}
+	const Weight getEdgeFlow(int id) {
+		assert(g.edgeEnabled(id));
+		return F[id];
+	}
+	const Weight getEdgeResidualCapacity(int id) {
+		assert(g.edgeEnabled(id));
+		return g.getWeight(id) - F[id];
+	}
+
+private:
+
+	void finishUpdate() {
+		last_modification = g.modifications;
+		last_deletion = g.deletions;
+		last_addition = g.additions;
+		history_qhead = g.historySize();
+		g.updateAlgorithmHistory(this, alg_id, history_qhead);
+		last_history_clear = g.historyclears;
+	}
+
+	void markChanged(int edgeID) {
+		if (!changed[edgeID]) {
+			changed[edgeID] = true;
+			changed_edges.push_back(edgeID);
+		}
+	}
+
+	//Bring the local capacity of edgeID up to date with the graph, clipping its flow if necessary.
+	void setCapacity(int edgeID) {
+		Weight c = 0;
+		if (g.hasEdge(edgeID) && g.edgeEnabled(edgeID) && !g.selfLoop(edgeID))
+			c = g.getWeight(edgeID);
+		if (C[edgeID] == c)
+			return;
+		C[edgeID] = c;
+		if (F[edgeID] > c) {
+			Weight d = F[edgeID] - c;
+			F[edgeID] = c;
+			markChanged(edgeID);
+			int from = g.getEdge(edgeID).from;
+			int to = g.getEdge(edgeID).to;
+			excess[from] += d;
+			excess[to] -= d;
+			if (to != source && to != sink)
+				deficits.push_back(to);
+		}
+	}
+
+	//The i'th arc of u in the residual graph: the outgoing edges of u, followed by the incoming edges of u.
+	inline Weight residual(int u, int i, int & edgeID, int & w) {
+		int n_out = g.nIncident(u);
+		if (i < n_out) {
+			auto & e = g.incident(u, i);
+			edgeID = e.id;
+			w = e.node;
+			return C[edgeID] - F[edgeID];
+		} else {
+			auto & e = g.incoming(u, i - n_out);
+			edgeID = e.id;
+			w = e.node;
+			return F[edgeID];
+		}
+	}
+	//The residual capacity of the reverse of the i'th arc of u (from its other end back to u).
+	inline Weight reverseResidual(int u, int i, int & w) {
+		int n_out = g.nIncident(u);
+		if (i < n_out) {
+			auto & e = g.incident(u, i);
+			w = e.node;
+			return F[e.id];
+		} else {
+			auto & e = g.incoming(u, i - n_out);
+			w = e.node;
+			return C[e.id] - F[e.id];
+		}
+	}
+
+	inline void activate(int u) {
+		assert(label[u] < g.nodes());
+		active[label[u]].push_back(u);
+		if (label[u] > max_active)
+			max_active = label[u];
+	}
+
+	inline void push(int u, int i, int edgeID, int w, Weight amount) {
+		stats_pushes++;
+		if (i < g.nIncident(u))
+			F[edgeID] += amount;
+		else
+			F[edgeID] -= amount;
+		markChanged(edgeID);
+		excess[u] -= amount;
+		bool was_active = excess[w] > 0;
+		excess[w] += amount;
+		if (!was_active && excess[w] > 0 && w != source && w != sink && label[w] < g.nodes())
+			activate(w);
+	}
+
+	//Set each label to the exact distance to the sink in the residual graph (or nodes(), if the sink is unreachable),
+	//then saturate the arcs from the source to every node that can reach the sink.
+	void globalRelabel() {
+		stats_global_relabels++;
+		relabels_since_global = 0;
+		int n = g.nodes();
+		std::fill(label.begin(), label.end(), n);
+		std::fill(label_count.begin(), label_count.end(), 0);
+		std::fill(pos.begin(), pos.end(), 0);
+		Q.clear();
+		Q.push_back(sink);
+		label[sink] = 0;
+		label_count[0]++;
+		for (int j = 0; j < Q.size(); j++) {
+			int u = Q[j];
+			int n_arcs = g.nIncident(u) + g.nIncoming(u);
+			for (int i = 0; i < n_arcs; i++) {
+				int w;
+				if (reverseResidual(u, i, w) > 0 && label[w] == n && w != source) {
+					label[w] = label[u] + 1;
+					label_count[label[w]]++;
+					Q.push_back(w);
+				}
+			}
+		}
+		for (auto & bucket : active)
+			bucket.clear();
+		max_active = -1;
+		for (int u : Q) {
+			if (u != sink && excess[u] > 0)
+				activate(u);
+		}
+		int n_arcs = g.nIncident(source) + g.nIncoming(source);
+		for (int i = 0; i < n_arcs; i++) {
+			int edgeID, w;
+			Weight r = residual(source, i, edgeID, w);
+			if (r > 0 && w != source && label[w] < n)
+				push(source, i, edgeID, w, r);
+		}
+	}
+
+	void discharge(int u) {
+		int n = g.nodes();
+		while (excess[u] > 0) {
+			if (pos[u] == g.nIncident(u) + g.nIncoming(u)) {
+				relabel(u);
+				if (label[u] >= n)
+					return;
+				continue;
+			}
+			int edgeID, w;
+			Weight r = residual(u, pos[u], edgeID, w);
+			if (r > 0 && w != u && label[u] == label[w] + 1) {
+				push(u, pos[u], edgeID, w, std::min(excess[u], r));
+			} else {
+				pos[u]++;
+			}
+		}
+	}
+
+	void relabel(int u) {
+		stats_relabels++;
+		relabels_since_global++;
+		int n = g.nodes();
+		int old_label = label[u];
+		int new_label = n;
+		int n_arcs = g.nIncident(u) + g.nIncoming(u);
+		for (int i = 0; i < n_arcs; i++) {
+			int edgeID, w;
+			if (residual(u, i, edgeID, w) > 0 && w != u && label[w] + 1 < new_label)
+				new_label = label[w] + 1;
+		}
+		pos[u] = 0;
+		label_count[old_label]--;
+		if (label_count[old_label] == 0) {
+			//gap: no node above old_label can reach the sink anymore
+			stats_gaps++;
+			for (int v = 0; v < n; v++) {
+				if (label[v] > old_label && label[v] < n) {
+					label_count[label[v]]--;
+					label[v] = n;
+				}
+			}
+			new_label = n;
+		}
+		label[u] = new_label;
+		if (new_label < n)
+			label_count[new_label]++;
+	}
+
+	/**
+	 * Cancel up to 'amount' units of flow leaving u (if forward), or entering u (otherwise), along paths of
+	 * flow-carrying edges. A path ends at the source or sink, or at a node whose excess (if forward) or deficit
+	 * (otherwise) absorbs the cancelled flow. Flow cycles found along the way are cancelled as well.
+	 */
+	void cancelFlow(int u, Weight amount, bool forward) {
+		Weight cancelled = 0;
+		path_nodes.clear();
+		path_edges.clear();
+		path_nodes.push_back(u);
+		path_index[u] = 0;
+		walked.push_back(u);
+		while (cancelled < amount && path_nodes.size()) {
+			int x = path_nodes.back();
+			int n_arcs = forward ? g.nIncident(x) : g.nIncoming(x);
+			int edgeID = -1;
+			int y = -1;
+			for (; walk_pos[x] < n_arcs; walk_pos[x]++) {
+				auto & e = forward ? g.incident(x, walk_pos[x]) : g.incoming(x, walk_pos[x]);
+				if (F[e.id] > 0 && e.node != x) {
+					edgeID = e.id;
+					y = e.node;
+					break;
+				}
+			}
+			if (edgeID < 0) {
+				//dead end (only possible for the first node, unless the flow is unbalanced)
+				path_index[x] = -1;
+				path_nodes.pop_back();
+				if (path_edges.size()) {
+					path_edges.pop_back();
+					walk_pos[path_nodes.back()]++;
+				}
+				continue;
+			}
+			path_edges.push_back(edgeID);
+			if (path_index[y] >= 0) {
+				//a flow cycle
+				int start = path_index[y];
+				Weight m = F[edgeID];
+				for (int k = start; k < path_edges.size(); k++)
+					m = std::min(m, F[path_edges[k]]);
+				for (int k = start; k < path_edges.size(); k++) {
+					F[path_edges[k]] -= m;
+					markChanged(path_edges[k]);
+				}
+				truncatePath(start);
+				continue;
+			}
+			bool terminal = y == source || y == sink || (forward ? excess[y] > 0 : excess[y] < 0);
+			if (terminal) {
+				stats_cancelled_paths++;
+				Weight m = amount - cancelled;
+				for (int id : path_edges)
+					m = std::min(m, F[id]);
+				if (y != source && y != sink) {
+					Weight absorbed = excess[y];
+					if (!forward)
+						absorbed = -absorbed;
+					m = std::min(m, absorbed);
+				}
+				for (int id : path_edges) {
+					F[id] -= m;
+					markChanged(id);
+				}
+				if (forward) {
+					excess[u] += m;
+					excess[y] -= m;
+				} else {
+					excess[u] -= m;
+					excess[y] += m;
+				}
+				cancelled += m;
+				//retreat to the tail of the first edge that no longer carries flow (y itself is not on the path)
+				int k = 0;
+				while (k + 1 < path_edges.size() && F[path_edges[k]] > 0)
+					k++;
+				truncatePath(k);
+				continue;
+			}
+			path_index[y] = path_nodes.size();
+			path_nodes.push_back(y);
+			walked.push_back(y);
+		}
+		for (int v : path_nodes)
+			path_index[v] = -1;
+		for (int v : walked)
+			walk_pos[v] = 0;
+		walked.clear();
+	}
+
+	//Remove every node after path_nodes[k] from the path (along with the edges leading to them)
+	void truncatePath(int k) {
+		for (int j = k + 1; j < path_nodes.size(); j++)
+			path_index[path_nodes[j]] = -1;
+		path_nodes.resize(k + 1);
+		path_edges.resize(k);
+	}
+
+	void dbg_check_flow() {
+#ifndef NDEBUG
+		for (int u = 0; u < g.nodes(); u++) {
+			Weight inflow = 0;
+			for (int i = 0; i < g.nIncoming(u); i++)
+				inflow += F[g.incoming(u, i).id];
+			for (int i = 0; i < g.nIncident(u); i++)
+				inflow -= F[g.incident(u, i).id];
+			if (u != source && u != sink) {
+				assert(inflow == 0);
+				assert(excess[u] == 0);
+			}
+		}
+		for (int edgeID = 0; edgeID < g.edges(); edgeID++) {
+			assert(F[edgeID] >= 0);
+			assert(F[edgeID] <= C[edgeID]);
+		}
+#endif
+	}
+};
+}
+;
+#endif
@@ -29,6 +29,7 @@
 #include <monosat/dgl/Reach.h>
 //#include "monosat/core/Config.h"
 //#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 //#include <exception>
@@ -43,7 +44,7 @@ namespace dgl {
 template<typename Weight = int, class Status = typename Distance<Weight>::NullStatus>
 class RamalReps: public Distance<Weight>, public DynamicGraphAlgorithm {
 public:
-	static bool ever_warned_about_zero_weights;
+	static std::atomic<bool> ever_warned_about_negative_weights;
 	DynamicGraph<Weight> & g;
 	std::vector<Weight> & weights;
 	Status & status;
@@ -58,19 +59,27 @@ public:
 
 	int source;
 	Weight INF;
+	//Sum of the edge weights as of the last update; INF is kept larger than this.
+	Weight total_weight;
+	std::vector<Weight> local_weights;
 
 	std::vector<Weight> old_dist;
 	std::vector<int> changed;
 	std::vector<bool> node_changed;
 	std::vector<Weight> dist;
+	//Ties between paths of equal weight are broken by their number of zero-weight edges.
+	//Under this ordering every edge (including every zero-weight edge) has positive length, so the shortest path graph
+	//is acyclic even if the graph has cycles of zero-weight edges, and the algorithm below needs no other changes to support them.
+	std::vector<int> zeros;
 	std::vector<int> prev;
 	struct DistCmp {
 		std::vector<Weight> & _dist;
+		std::vector<int> & _zeros;
 		bool operator()(int a, int b) const {
-			return _dist[a] < _dist[b];
+			return _dist[a] < _dist[b] || (_dist[a] == _dist[b] && _zeros[a] < _zeros[b]);
 		}
-		DistCmp(std::vector<Weight> & d) :
-				_dist(d) {
+		DistCmp(std::vector<Weight> & d, std::vector<int> & z) :
+				_dist(d), _zeros(z) {
 		}
 		;
 	};
@@ -115,7 +124,7 @@ public:
 		}
 	} local_distance_status;
 	Dijkstra<Weight,LocalDistanceStatus> dijkstras;
-	bool has_zero_weights=false;
+	bool has_negative_weights=false;
 public:
 	
 	long stats_full_updates=0;
@@ -124,6 +133,7 @@ public:
 	long stats_skip_deletes=0;
 	long stats_skipped_updates=0;
 	long stats_num_skipable_deletions=0;
+	long stats_weight_changes=0;
 	double mod_percentage=0;
 
 	double stats_full_update_time=0;
@@ -132,7 +142,7 @@ public:
 			bool reportDistance = false) :
 			g(graph), weights(g.getWeights()), status(status), reportPolarity(reportPolarity), reportDistance(reportDistance), last_modification(
 					-1), last_addition(-1), last_deletion(-1), history_qhead(0), last_history_clear(0), source(s), INF(
-					0), q(DistCmp(dist)),local_distance_status(*this),dijkstras(s,graph,local_distance_status,reportPolarity) {
+					0), total_weight(0), q(DistCmp(dist,zeros)),local_distance_status(*this),dijkstras(s,graph,local_distance_status,reportPolarity) {
 		
 		mod_percentage = 0.2;
 		alg_id=g.addDynamicAlgorithm(this);
@@ -159,7 +169,35 @@ public:
 	void drawFull() {
 		
 	}
-	
+
+private:
+	//True if a path of weight da with za zero-weight edges is shorter than one of weight db with zb zero-weight edges.
+	inline bool shorter(const Weight & da, int za, const Weight & db, int zb) const {
+		return da < db || (da == db && za < zb);
+	}
+	inline int isZero(int edgeID) const {
+		return weights[edgeID] == 0 ? 1 : 0;
+	}
+	void updateWeight(int edgeID) {
+		Weight & w = weights[edgeID];
+		if (w < 0)
+			has_negative_weights = true;
+		total_weight += w - local_weights[edgeID];
+		local_weights[edgeID] = w;
+	}
+	//Change the value used to represent unreachable nodes
+	void setInfinity(const Weight & newInf) {
+		if (newInf == INF)
+			return;
+		for (int i = 0; i < dist.size(); i++) {
+			if (dist[i] == INF) {
+				dist[i] = newInf;
+			}
+		}
+		INF = newInf;
+	}
+public:
+
 	void dbg_delta() {
 #ifdef DEBUG_RAMAL
 		dbg_delta_lite();
@@ -173,20 +211,12 @@ public:
 		
 		std::vector<int> dbg_delta;
 		std::vector<Weight> dbg_dist;
+		std::vector<int> dbg_zeros;
 		dbg_dist.resize(g.nodes(), INF);
+		dbg_zeros.resize(g.nodes(), 0);
 		dbg_delta.resize(g.nodes());
 		dbg_dist[getSource()] = 0;
-		struct DistCmp {
-			std::vector<Weight> & _dist;
-			bool operator()(int a, int b) const {
-				return _dist[a] < _dist[b];
-			}
-			DistCmp(std::vector<Weight> & d) :
-					_dist(d) {
-			}
-			;
-		};
-		Heap<DistCmp> q(dbg_dist);
+		Heap<DistCmp> q(DistCmp(dbg_dist, dbg_zeros));
 		
 		q.insert(getSource());
 		
@@ -196,19 +226,6 @@ public:
 				break;
 			dbg_delta[u] = 0;
 			
-			for (int i = 0; i < g.nIncoming(u); i++) {
-				if (!g.edgeEnabled(g.incoming(u, i).id))
-					continue;
-				
-				int edgeID = g.incoming(u, i).id;
-				int v = g.getEdge(edgeID).from;
-				Weight alt = dbg_dist[v] + weights[edgeID];
-				assert(alt >= dbg_dist[u]);
-				/*	if (alt==dbg_dist[u]){
-				 dbg_delta[u]++;
-				 }*/
-			}
-			
 			for (int i = 0; i < g.nIncident(u); i++) {
 				if (!g.edgeEnabled(g.incident(u, i).id))
 					continue;
@@ -216,24 +233,20 @@ public:
 				int edgeID = g.incident(u, i).id;
 				int v = g.getEdge(edgeID).to;
 				Weight alt = dbg_dist[u] + weights[edgeID];
-				if (alt < dbg_dist[v]) {
-					
+				int zalt = dbg_zeros[u] + isZero(edgeID);
+				if (shorter(alt, zalt, dbg_dist[v], dbg_zeros[v])) {
 					dbg_dist[v] = alt;
-					
-					if (!q.inHeap(v))
-						q.insert(v);
-					else
-						q.decrease(v);
-				}/*else if (alt==dbg_dist[v]){
-				 dbg_delta[v]++;
-				 }*/
+					dbg_zeros[v] = zalt;
+					q.update(v);
+				}
 			}
 		}
 		
 		for (int u = 0; u < g.nodes(); u++) {
-			Weight & d = dist[u];
-			
 			assert(dbg_dist[u] == dist[u]);
+			if (dist[u] == INF)
+				continue;
+			assert(dbg_zeros[u] == zeros[u]);
 			for (int i = 0; i < g.nIncoming(u); i++) {
 				if (!g.edgeEnabled(g.incoming(u, i).id))
 					continue;
@@ -242,36 +255,25 @@ public:
 				int v = g.getEdge(edgeID).from;
 				
 				Weight alt = dbg_dist[v] + weights[edgeID];
-				assert(alt >= dbg_dist[u]);
-				if (alt == dbg_dist[u]) {
-					dbg_delta[u]++; //is this right?
+				int zalt = dbg_zeros[v] + isZero(edgeID);
+				assert(!shorter(alt, zalt, dbg_dist[u], dbg_zeros[u]));
+				if (alt == dbg_dist[u] && zalt == dbg_zeros[u]) {
+					dbg_delta[u]++;
 					assert(edgeInShortestPathGraph[edgeID]);
 				} else {
 					assert(!edgeInShortestPathGraph[edgeID]);
 				}
-				
 			}
-			
-		}
-		for (int u = 0; u < g.nodes(); u++) {
-			Weight& d = dist[u];
-			Weight& d_expect = dbg_dist[u];
-			assert(d == dbg_dist[u]);
-			
 		}
 		for (int u = 0; u < g.nodes(); u++) {
-			int d = delta[u];
-			int d_expect = dbg_delta[u];
-			assert(d == dbg_delta[u]);
-			
+			if (dist[u] != INF)
+				assert(delta[u] == dbg_delta[u]);
 		}
 		dbg_delta_lite();
 #endif
 	}
 	
 	void GRRInc(int edgeID) {
-		static int iter = 0;
-		++iter;
 		dbg_delta_lite();
 		assert(g.edgeEnabled(edgeID));
 		if (edgeInShortestPathGraph[edgeID])
@@ -279,13 +281,11 @@ public:
 		int ru = g.getEdge(edgeID).from;
 		int rv = g.getEdge(edgeID).to;
 		
-		Weight & rdv = dist[rv];
-		Weight & rdu = dist[ru];
-		
-		Weight& weight = weights[edgeID];
-		if (dist[rv] < dist[ru] + weight)
+		Weight alt = dist[ru] + weights[edgeID];
+		int zalt = zeros[ru] + isZero(edgeID);
+		if (shorter(dist[rv], zeros[rv], alt, zalt))
 			return;
-		else if (dist[rv] == dist[ru] + weight) {
+		else if (dist[rv] == alt && zeros[rv] == zalt) {
 			assert(!edgeInShortestPathGraph[edgeID]);
 			edgeInShortestPathGraph[edgeID] = true;
 			delta[rv]++; //we have found an alternative shortest path to v
@@ -293,7 +293,8 @@ public:
 		}
 		edgeInShortestPathGraph[edgeID] = true;
 		delta[rv]++;
-		dist[rv] = dist[ru] + weight;
+		dist[rv] = alt;
+		zeros[rv] = zalt;
 		q.clear();
 		q.insert(rv);
 		
@@ -313,21 +314,15 @@ public:
 					
 					assert(g.getEdge(adjID).to == u);
 					int v = g.getEdge(adjID).from;
-					Weight & w = weights[adjID]; //assume a weight of one for now
-					Weight & du = dist[u];
-					Weight & dv = dist[v];
-					if (dist[u] == dist[v] + w) {
+					Weight alt = dist[v] + weights[adjID];
+					int zalt = zeros[v] + isZero(adjID);
+					if (dist[u] == alt && zeros[u] == zalt) {
 						edgeInShortestPathGraph[adjID] = true;
 						delta[u]++;
-					} else if (dist[u] < (dist[v] + w)) {
-						//This doesn't hold for us, because we are allowing multiple edges to be added at once.
-						//assert(dist[u]<(dist[v]+w));
-						
-						edgeInShortestPathGraph[adjID] = false;
 					} else {
-						//don't do anything. This will get corrected in a future call to GRRInc.
-						//assert(false);
-						
+						//If this edge is shorter than the path to u, then either it was enabled, or its weight was decreased,
+						//in this same update. Either way, it will be handled by a later call to GRRInc.
+						edgeInShortestPathGraph[adjID] = false;
 					}
 				} else {
 					edgeInShortestPathGraph[adjID] = false;	//need to add this, because we may have disabled multiple edges at once.
@@ -340,13 +335,13 @@ public:
 				if (g.edgeEnabled(adjID)) {
 					assert(g.getEdge(adjID).from == u);
 					int s = g.getEdge(adjID).to;
-					Weight & w = weights[adjID];							//assume a weight of one for now
-					Weight & du = dist[u];
-					Weight & ds = dist[s];
-					if (dist[s] > dist[u] + w) {
-						dist[s] = dist[u] + w;
+					Weight alt = dist[u] + weights[adjID];
+					int zalt = zeros[u] + isZero(adjID);
+					if (shorter(alt, zalt, dist[s], zeros[s])) {
+						dist[s] = alt;
+						zeros[s] = zalt;
 						q.update(s);
-					} else if (dist[s] == dist[u] + w && !edgeInShortestPathGraph[adjID]) {
+					} else if (dist[s] == alt && zeros[s] == zalt && !edgeInShortestPathGraph[adjID]) {
 						edgeInShortestPathGraph[adjID] = true;
 						delta[s]++;
 					}
@@ -359,14 +354,10 @@ public:
 #ifdef DEBUG_RAMAL
 		for (int u = 0; u < g.nodes(); u++) {
 			int del = delta[u];
-			Weight d = dist[u];
 			int num_in = 0;
 			for (int i = 0; i < g.nIncoming(u); i++) {
 				auto & e = g.incoming(u, i);
 				int adjID = e.id;
-				int from = g.getEdge(adjID).from;
-				
-				Weight dfrom = dist[from];
 				if (edgeInShortestPathGraph[adjID])
 					num_in++;
 			}
@@ -376,9 +367,9 @@ public:
 		
 	}
 	
+	//Called when an edge that may be in the shortest path graph is disabled, or becomes longer than the shortest path to its target.
 	void GRRDec(int edgeID) {
 		dbg_delta_lite();
-		assert(!g.edgeEnabled(edgeID));
 		//First, check if this edge is actually in the shortest path graph
 		if (!edgeInShortestPathGraph[edgeID])
 			return;
@@ -399,6 +390,7 @@ public:
 		for (int i = 0; i < changeset.size(); i++) {
 			int u = changeset[i];
 			dist[u] = INF;
+			zeros[u] = 0;
 			for (int i = 0; i < g.nIncident(u); i++) {
 				auto & e = g.incident(u, i);
 				int adjID = e.id;
@@ -427,11 +419,12 @@ public:
 				if (g.edgeEnabled(adjID)) {
 					assert(g.getEdge(adjID).to == u);
 					int v = g.getEdge(adjID).from;
-					Weight & w = weights[adjID]; //assume a weight of one for now
-					Weight alt = dist[v] + w;
+					Weight alt = dist[v] + weights[adjID];
+					int zalt = zeros[v] + isZero(adjID);
 					assert(!edgeInShortestPathGraph[adjID]);
-					if (dist[u] > alt) {
+					if (shorter(alt, zalt, dist[u], zeros[u])) {
 						dist[u] = alt;
+						zeros[u] = zalt;
 					}
 				}
 				
@@ -479,9 +472,9 @@ public:
 				if (g.edgeEnabled(adjID)) {
 					assert(g.getEdge(adjID).from == u);
 					int s = g.getEdge(adjID).to;
-					Weight w = weights[adjID];				//assume a weight of one for now
-					Weight alt = dist[u] + w;
-					if (dist[s] > alt) {
+					Weight alt = dist[u] + weights[adjID];
+					int zalt = zeros[u] + isZero(adjID);
+					if (shorter(alt, zalt, dist[s], zeros[s])) {
 						if (reportPolarity >= 0 && dist[s] >= 0) {
 							//This check is needed (in addition to the above), because even if we are NOT reporting distances, it is possible for a node that was previously not reachable
 							//to become reachable here. This is ONLY possible because we are batching multiple edge incs/decs at once (otherwise it would be impossible for removing an edge to decrease the distance to a node).
@@ -492,8 +485,9 @@ public:
 						}
 						
 						dist[s] = alt;
+						zeros[s] = zalt;
 						q.update(s);
-					} else if (dist[s] == alt && !edgeInShortestPathGraph[adjID]) {
+					} else if (dist[s] == alt && zeros[s] == zalt && !edgeInShortestPathGraph[adjID]) {
 						edgeInShortestPathGraph[adjID] = true;
 						delta[s]++;							//added by sam... not sure if this is correct or not.
 					}
@@ -507,26 +501,48 @@ public:
 					
 					assert(g.getEdge(adjID).to == u);
 					int v = g.getEdge(adjID).from;
-					Weight & dv = dist[v];
-					Weight & du = dist[u];
-					bool edgeIn = edgeInShortestPathGraph[adjID];
-					Weight & w = weights[adjID];							//assume a weight of one for now
-					if (dist[u] == dist[v] + w && !edgeInShortestPathGraph[adjID]) {
+					Weight alt = dist[v] + weights[adjID];
+					int zalt = zeros[v] + isZero(adjID);
+					if (dist[u] == alt && zeros[u] == zalt && !edgeInShortestPathGraph[adjID]) {
 						assert(!edgeInShortestPathGraph[adjID]);
 						edgeInShortestPathGraph[adjID] = true;
 						delta[u]++;
-					} else if (dist[u] < dist[v] + w && edgeInShortestPathGraph[adjID]) {
+					} else if (shorter(dist[u], zeros[u], alt, zalt) && edgeInShortestPathGraph[adjID]) {
 						edgeInShortestPathGraph[adjID] = false;
 						delta[u]--;
 						assert(!edgeInShortestPathGraph[adjID]);
-					} else if (dist[u] > dist[v] + w) {
-						//assert(false);
 					}
 				}
 			}
 		}
 		dbg_delta_lite();
 	}
+
+	//Called when the weight of an edge has changed.
+	void GRRWeightChange(int edgeID) {
+		if (!g.edgeEnabled(edgeID))
+			return; //disabled edges are not in the shortest path graph, and will be handled by GRRInc when they are enabled.
+		if (!edgeInShortestPathGraph[edgeID]) {
+			GRRInc(edgeID);
+			return;
+		}
+		int ru = g.getEdge(edgeID).from;
+		int rv = g.getEdge(edgeID).to;
+		Weight alt = dist[ru] + weights[edgeID];
+		int zalt = zeros[ru] + isZero(edgeID);
+		if (dist[rv] == alt && zeros[rv] == zalt) {
+			return; //still a shortest path to rv
+		} else if (shorter(dist[rv], zeros[rv], alt, zalt)) {
+			//the edge is no longer on a shortest path to rv, so treat it as if it had been removed
+			GRRDec(edgeID);
+		} else {
+			//the edge now gives a shorter path to rv, so remove it from the shortest path graph and re-insert it
+			edgeInShortestPathGraph[edgeID] = false;
+			assert(delta[rv] > 0);
+			delta[rv]--;
+			GRRInc(edgeID);
+		}
+	}
 	
 	long num_updates = 0;
 	int numUpdates() const {
@@ -539,36 +555,28 @@ public:
 			fprintf(g.outfile, "r %d\n", getSource());
 		}
 
-		static int iteration = 0;
-		int local_it = ++iteration;
-		if (local_it == 7668) {
-			int a = 1;
-		}
 		if (last_modification > 0 && g.modifications == last_modification)
 			return;
 		if (last_modification <= 0 || g.changed()) {
-			Weight oldInf = INF;
-			INF = 1;							//g.nodes()+1;
-			has_zero_weights=false;
-			for (Weight & w : weights) {
-				if (w <= 0) {
+			total_weight = 0;
+			local_weights.resize(g.edges());
+			for (int edgeID = 0; edgeID < g.edges(); edgeID++) {
+				Weight & w = weights[edgeID];
+				if (w < 0) {
 					//Note: in the future, we could implement the DFMN algorithm (Maintaining Shortest Paths in Digraphs with Arbitrary Arc Weights: An Experimental Study), which does support negative length weights, but is slower than RR.
-					//throw std::invalid_argument("Ramalingham-Reps doesn't support zero-weight edges (select a different distance algorithm, such as dijkstra)");
 					//for the moment: the _first_ time <0 weights are detected, simply fallback on dijkstra's, permanently.
-
-					has_zero_weights=true;
+					has_negative_weights=true;
 				}
-				INF += w;
+				local_weights[edgeID] = w;
+				total_weight += w;
 			}
-			if(INF!=oldInf){
-				for(int i = 0;i<dist.size();i++){
-					if(dist[i]==oldInf){
-						dist[i]=INF;
-					}
-				}
+			if (!(total_weight < INF)) {
+				setInfinity(total_weight + 1);
 			}
 			dist.resize(g.nodes(), INF);
+			zeros.resize(g.nodes(), 0);
 			dist[getSource()] = 0;
+			zeros[getSource()] = 0;
 			delta.resize(g.nodes());
 			node_changed.resize(g.nodes(), true);
 			
@@ -581,31 +589,53 @@ public:
 		}
 		edgeInShortestPathGraph.resize(g.nEdgeIDs());
 
-		if(has_zero_weights){
-			if(!ever_warned_about_zero_weights){
-				ever_warned_about_zero_weights=true;
-				fprintf(stderr,"Warning: Ramalingham-Reps doesn't support zero-weight edges; falling back on Dijkstra's (which is much slower)\n");
+		bool history_cleared = last_history_clear != g.historyclears;
+		//Edge weights may have increased since the last update, so INF may need to be raised before any distances are recomputed.
+		if (history_cleared) {
+			for (int edgeID = 0; edgeID < g.edges(); edgeID++) {
+				updateWeight(edgeID);
+			}
+		} else {
+			for (int i = history_qhead; i < g.historySize(); i++) {
+				auto & change = g.getChange(i);
+				if (change.weight_increase || change.weight_decrease) {
+					updateWeight(change.id);
+				}
+			}
+		}
+		if (!(total_weight < INF)) {
+			//leave some slack, so that INF does not need to be raised again on every increase
+			setInfinity(total_weight + total_weight + 1);
+		}
+
+		if(has_negative_weights){
+			if(!ever_warned_about_negative_weights.exchange(true)){
+				fprintf(stderr,"Warning: Ramalingham-Reps doesn't support negative-weight edges; falling back on Dijkstra's (which is much slower)\n");
 			}
 			dijkstras.update();
 		}else{
 
-			if (last_history_clear != g.historyclears) {
+			if (history_cleared) {
 				history_qhead = g.historySize();
 				last_history_clear = g.historyclears;
 				for (int edgeid = 0; edgeid < g.edges(); edgeid++) {
 					if (g.edgeEnabled(edgeid)) {
-						GRRInc(edgeid);
+						GRRWeightChange(edgeid);
 					} else {
 						GRRDec(edgeid);
 					}
 				}
 			}
 			for (int i = history_qhead; i < g.historySize(); i++) {
-				int edgeid = g.getChange(i).id;
-				if (g.getChange(i).addition && g.edgeEnabled(edgeid)) {
+				auto & change = g.getChange(i);
+				int edgeid = change.id;
+				if (change.addition && g.edgeEnabled(edgeid)) {
 					GRRInc(edgeid);
-				} else if (!g.getChange(i).addition && !g.edgeEnabled(edgeid)) {
+				} else if (change.deletion && !g.edgeEnabled(edgeid)) {
 					GRRDec(edgeid);
+				} else if (change.weight_increase || change.weight_decrease) {
+					stats_weight_changes++;
+					GRRWeightChange(edgeid);
 				}
 			}
 		}
@@ -663,7 +693,7 @@ public:
 	}
 	bool dbg_uptodate() {
 #ifdef DEBUG_RAMAL
-		if(last_modification<0)
+		if(last_modification<0 || has_negative_weights)
 		 return true;
 		 dbg_delta();
 		 Dijkstra<Weight> d(source,g);
@@ -688,7 +718,7 @@ public:
 	
 	bool connected_unsafe(int t) {
 		dbg_uptodate();
-		if(has_zero_weights){
+		if(has_negative_weights){
 			return dijkstras.connected_unsafe(t);
 		}
 		return t < dist.size() && dist[t] < INF;
@@ -702,7 +732,7 @@ public:
 			update();
 
 		assert(dbg_uptodate());
-		if(has_zero_weights){
+		if(has_negative_weights){
 			return dijkstras.connected(t);
 		}
 		return dist[t] < INF;
@@ -710,7 +740,7 @@ public:
 	Weight & distance(int t) {
 		if (last_modification != g.modifications)
 			update();
-		if(has_zero_weights){
+		if(has_negative_weights){
 			return dijkstras.distance(t);
 		}
 		if (connected_unsafe(t))
@@ -719,7 +749,7 @@ public:
 			return this->unreachable();
 	}
 	Weight &distance_unsafe(int t) {
-		if(has_zero_weights){
+		if(has_negative_weights){
 			return dijkstras.distance_unsafe(t);
 		}
 		if (connected_unsafe(t))
@@ -728,7 +758,7 @@ public:
 			return this->unreachable();
 	}
 	int incomingEdge(int t) {
-		if(has_zero_weights){
+		if(has_negative_weights){
 			return dijkstras.incomingEdge(t);
 		}
 		if (!connected_unsafe(t)){
@@ -739,65 +769,28 @@ public:
 
 		assert( dist[t]>=0);
 		assert( dist[t]!=INF);
-		int prev = -1;
-		int prev_edgeID=-1;
-		Weight min_prev_dist= dist[t];
+		//Any edge of the shortest path graph leads back towards the source; because every edge has positive length
+		//(counting zero-weight edges as longer than no edge at all), following these edges always terminates at the source.
 		for(int i = 0;i<g.nIncoming(t);i++){
-
 			int edgeID = g.incoming(t,i).id;
 			if(g.edgeEnabled(edgeID)){
 				int from = g.incoming(t,i).node;
-				if(connected_unsafe(from)){
-					assert(dist[from]>=0);
-					assert(dist[from]!=INF);
-					//Note: RamalReps doesn't support 0-weighted edges, so it is safe to assume that the previous node on the path has a lower distance from the source
-					if (dist[from]<min_prev_dist){
-						min_prev_dist=dist[from];
-						prev = from;
-						prev_edgeID=edgeID;
-					}
+				if(connected_unsafe(from) && dist[from] + weights[edgeID] == dist[t] && zeros[from] + isZero(edgeID) == zeros[t]){
+					return edgeID;
 				}
 			}
 		}
-		assert(prev!=-1);
-		assert(min_prev_dist<dist[t]);
-
-		return prev_edgeID;
+		assert(false);
+		return -1;
 	}
 	int previous(int t) {
-		if(has_zero_weights){
+		if(has_negative_weights){
 			return dijkstras.previous(t);
 		}
-		if (!connected_unsafe(t)){
-			return -1;
-		}
-		if(t==source)
+		int edgeID = incomingEdge(t);
+		if (edgeID < 0)
 			return -1;
-
-		assert( dist[t]>=0);
-		assert( dist[t]!=INF);
-		int prev = -1;
-		Weight min_prev_dist= dist[t];
-		for(int i = 0;i<g.nIncoming(t);i++){
-
-			int edgeID = g.incoming(t,i).id;
-			if(g.edgeEnabled(edgeID)){
-				int from = g.incoming(t,i).node;
-				if(connected_unsafe(from)){
-					assert(dist[from]>=0);
-					assert(dist[from]!=INF);
-					//Note: RamalReps doesn't support 0-weighted edges, so it is safe to assume that the previous node on the path has a lower distance from the source
-					if (dist[from]<min_prev_dist){
-						min_prev_dist=dist[from];
-						prev = from;
-					}
-				}
-			}
-		}
-		assert(prev!=-1);
-		assert(min_prev_dist<dist[t]);
-
-		return prev;
+		return g.getEdge(edgeID).from;
 	}
 };
 
@@ -1018,8 +1011,6 @@ public:
 	}
 	
 	void GRRInc(int edgeID) {
-		static int iter = 0;
-		++iter;
 		dbg_delta_lite();
 		assert(g.edgeEnabled(edgeID));
 		if (edgeInShortestPathGraph[edgeID])
@@ -1670,7 +1661,7 @@ public:
 	}
 };
 template<typename Weight, class Status>
-bool RamalReps<Weight,Status>::ever_warned_about_zero_weights = 0;
+std::atomic<bool> RamalReps<Weight,Status>::ever_warned_about_negative_weights{false};
 }
 ;
 #endif
@@ -652,8 +652,6 @@ public:
 		return num_updates;
 	}
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 
 		if (g.outfile) {
 			fprintf(g.outfile, "m\n");
@@ -96,8 +96,6 @@ public:
 	}
 	
 	void update() {
-		static int iteration = 0;
-		int local_it = ++iteration;
 
 		if (g.outfile) {
 			fprintf(g.outfile, "m\n");
@@ -420,11 +420,6 @@ private:
 					//note: we only visit this search loop if we have not already found a replacement edge.
 					int w = n ? treeEdge.to : treeEdge.from;
 					dbg_incident();
-					static int iter = 0;
-					if (++iter == 93) {
-						int a = 1;
-						int b = 2;
-					}
 					foundReplacement = visit(w, u, edgeID, i, replacementEdge);
 					dbg_incident();
 				}
@@ -728,10 +723,6 @@ public:
 	 * Returns true if the set of connected components have changed
 	 */
 	bool setEdgeEnabled(int from, int to, int edgeID, bool enabled) {
-		static int iter = 0;
-		if (++iter == 531) {
-			int a = 1;
-		}
 		addEdge(from, to, edgeID);
 		bool changed = false;
 		/*	if(enabled)
@@ -758,10 +749,6 @@ public:
 		return changed;
 	}
 	bool setEdgeEnabledUnchecked(int from, int to, int edgeID, bool connected) {
-		static int iter = 0;
-		if (++iter == 531) {
-			int a = 1;
-		}
 		addEdge(from, to, edgeID);
 		bool changed = false;
 		
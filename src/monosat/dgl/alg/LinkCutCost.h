@@ -350,10 +350,6 @@ public:
 	
 	void dbg_isGrossMin(int min, int v) {
 #ifndef NDEBUG_LINKCUT
-		static int iter = 0;
-		if (++iter == 22349) {
-			int a = 1;
-		}
 		// dbg_print_forest();
 		Weight minGrossCost = nodes[v].cost;
 		
@@ -447,7 +447,6 @@ public:
 	}
 
 	void backtrackUntil(int level) {
-		static int it = 0;
 		
 		bool changed = false;
 		//need to remove and add edges in the two graphs accordingly.
@@ -503,7 +502,7 @@ public:
 		return true;
 	}
 	Lit decideTheory() {
-		if (!opt_decide_theories)
+		if (!S->getConfig().decide_theories)
 			return lit_Undef;
 		double start = rtime(1);
 
@@ -682,10 +681,6 @@ public:
 	}
 
 	bool propagateTheory(vec<Lit> & conflict, bool force_propagation) {
-		static int itp = 0;
-		if (++itp == 11673) {
-			int a = 1;
-		}
 		stats_propagations++;
 
 		if (!requiresPropagation) {
@@ -696,7 +691,7 @@ public:
 		
 		propagations++;
 
-		if (propagations>1 && (!force_propagation && (propagations % opt_fsm_prop_skip != 0))){
+		if (propagations>1 && (!force_propagation && (propagations % S->getConfig().fsm_prop_skip != 0))){
 			stats_propagations_skipped++;
 			return true;
 		}
@@ -756,7 +751,7 @@ public:
 			assert(propagateTheory(conflict,true));
 		}
 		//Under normal conditions, this should _always_ hold (as propagateTheory should have been called and checked by the parent solver before getting to this point).
-		assert(ret || opt_fsm_prop_skip>1);
+		assert(ret || S->getConfig().fsm_prop_skip>1);
 		return ret;
 	}
 	;
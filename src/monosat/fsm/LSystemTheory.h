@@ -365,7 +365,6 @@ public:
 	}
 	
 	void backtrackUntil(int level) {
-		static int it = 0;
 		
 		bool changed = false;
 		//need to remove and add edges in the two graphs accordingly.
@@ -420,7 +419,7 @@ public:
 		return true;
 	}
 	Lit decideTheory() {
-		if (!opt_decide_theories)
+		if (!S->getConfig().decide_theories)
 			return lit_Undef;
 		double start = rtime(1);
 		
@@ -591,10 +590,6 @@ public:
 	}
 	;
 	bool propagateTheory(vec<Lit> & conflict) {
-		static int itp = 0;
-		if (++itp == 62279) {
-			int a = 1;
-		}
 		stats_propagations++;
 		dbg_sync();
 		if (!requiresPropagation) {
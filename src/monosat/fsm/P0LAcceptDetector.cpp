@@ -79,10 +79,6 @@ void P0LAcceptDetector::addProducesLit(int atom,int strID, Var outer_reach_var){
 
 
 bool P0LAcceptDetector::propagate(vec<Lit> & conflict) {
-	static int iter = 0;
-	if (++iter == 87) {
-		int a = 1;
-	}
 	changed.clear();
 	bool skipped_positive = false;
 	if (underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0)) {
@@ -170,7 +166,7 @@ void P0LAcceptDetector::buildReason(Lit p, vec<Lit> & reason, CRef marker) {
 
 void P0LAcceptDetector::buildAcceptReason(int atom,int str, vec<Lit> & conflict){
 	//the reason the string was accepted is simply the set of all unique ruleIDs that were traversed accepting the string.
-	static vec<int> store_edges;
+	static thread_local vec<int> store_edges;
 	store_edges.clear();
 	bool r = underapprox_detector->getUsedRules(str,store_edges);
 	assert(r);
@@ -415,8 +411,6 @@ int P0LAcceptDetector::check_accepts(int str,int depth,vec<int> * blocking_edges
 		if(depth>9)
 			return 0;
 		int atom = 0;
-		static int iter = 0;
-		++iter;
 
 		assert(stringset.size()>depth || depth==0);
 		assert(fsmstrings.size()>str);
@@ -495,8 +489,8 @@ bool P0LAcceptDetector::accepts_rec(int atom,int str,int depth,vec<int> * blocki
 }
 
 void P0LAcceptDetector::analyzeNFT(int atom,int source, int final,vec<int> & string,vec<int> & blocking,vec<Bitset> & suffixTable){
-		static vec<int> to_visit;
-		static vec<int> next_visit;
+		static thread_local vec<int> to_visit;
+		static thread_local vec<int> next_visit;
 
 		//explain why this transducer only produces the set of strings it produces, and not others, given this string as input.
 		//build FULL, level-0 overapprox suffix table to filter the dfs exploration below.
@@ -508,8 +502,8 @@ void P0LAcceptDetector::analyzeNFT(int atom,int source, int final,vec<int> & str
 		to_visit.clear();
 		next_visit.clear();
 
-		static vec<bool> cur_seen;
-		static vec<bool> next_seen;
+		static thread_local vec<bool> cur_seen;
+		static thread_local vec<bool> next_seen;
 		cur_seen.clear();
 		cur_seen.growTo(acceptor.states());
 
@@ -700,8 +694,6 @@ void P0LAcceptDetector::updateAcceptor(){
 			stats_skipped_updates++;
 			return;
 		}
-		static int iteration = 0;
-		int local_it = ++iteration;
 		stats_full_updates++;
 
 		if (last_deletion == g.deletions) {
@@ -742,7 +734,7 @@ void P0LAcceptDetector::updateAcceptor(){
 }
 
 void P0LAcceptDetector::buildNonAcceptReason(int atom,int str, vec<Lit> & conflict){
-	static vec<int> store_edges;
+	static thread_local vec<int> store_edges;
 	store_edges.clear();
 
 	updateAcceptor();
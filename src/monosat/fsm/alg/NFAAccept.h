@@ -271,8 +271,6 @@ public:
 			return;
 		}
 
-		static int iteration = 0;
-		int local_it = ++iteration;
 		stats_full_updates++;
 
 		if (last_deletion == g.deletions) {
@@ -141,8 +141,6 @@ public:
 			stats_skipped_updates++;
 			return;
 		}
-		static int iteration = 0;
-		int local_it = ++iteration;
 		stats_full_updates++;
 
 		if (last_deletion == g.deletions) {
@@ -198,7 +196,7 @@ public:
 
 	//inefficient!
 	bool generatesString(int string){
-		static vec<NFATransition> ignore;
+		static thread_local vec<NFATransition> ignore;
 		ignore.clear();
 		return getPath(string, ignore);
 	}
@@ -225,8 +225,6 @@ public:
 			stats_skipped_updates++;
 			return;
 		}
-		static int iteration = 0;
-		int local_it = ++iteration;
 		stats_full_updates++;
 
 		if (last_deletion == g.deletions) {
@@ -286,7 +284,7 @@ public:
 	//inefficient!
 	//If state is -1, then this is true if any state accepts the string.
 	bool transducesString(int string1,int string2, int state){
-		static vec<NFATransition> ignore;
+		static thread_local vec<NFATransition> ignore;
 		ignore.clear();
 		return getPath(string1,string2,state,ignore);
 		/*run(string1);
@@ -166,8 +166,6 @@ public:
 			stats_skipped_updates++;
 			return;
 		}
-		static int iteration = 0;
-		int local_it = ++iteration;
 		stats_full_updates++;
 
 		if (last_deletion == g.deletions) {
@@ -463,8 +461,6 @@ private:
 	bool accepts_rec(int str,int depth,vec<bool> & used_edges,vec<int> & used_rule_set,vec<int> * blocking_edges){
 		if(depth>9)
 			return false;
-		static int iter = 0;
-		++iter;
 
 		assert(stringset.size()>depth || depth==0);
 		assert(fsmstrings.size()>str);
@@ -497,8 +493,6 @@ private:
 	}
 	int check_accepts(int str,int depth,vec<bool> & used_edges,vec<int> & used_rule_set,vec<int> * blocking_edges){
 
-		static int iter = 0;
-		++iter;
 
 		assert(stringset.size()>depth || depth==0);
 		assert(fsmstrings.size()>str);
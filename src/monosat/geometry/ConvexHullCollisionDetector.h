@@ -262,8 +262,6 @@ bool ConvexHullCollisionDetector<D, T>::propagate(vec<Lit> & conflict) {
 	
 	//for now, I'm just iterating through each possible collision and doing pairwise checks. In the future, it would be nice to make this more efficient.
 	for (auto & c : collisionLits) {
-		static int iter = 0;
-		++iter;
 		//this is really ugly.
 		auto & h1_under = convexHullDetectors[c.pointSet1]->getConvexHull(false)->getHull();
 		auto & h1_over = convexHullDetectors[c.pointSet1]->getConvexHull(true)->getHull();
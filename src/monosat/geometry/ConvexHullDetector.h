@@ -107,16 +107,16 @@ public:
 	};
 	std::vector<AreaLit> areaDetectors;
 
-	static long stats_propagations;
-	static long stats_bound_checks;
-	static long stats_bounds_skips_under;
-	static long stats_bounds_skips_over;
-	static long stats_under_clause_length;
-	static long stats_over_clause_length;
-	static long stats_under_clauses;
-	static long stats_over_clauses;
-	static long stats_line_intersection_skips_under;
-	static long stats_line_intersection_skips_over;
+	long stats_propagations = 0;
+	long stats_bound_checks = 0;
+	long stats_bounds_skips_under = 0;
+	long stats_bounds_skips_over = 0;
+	long stats_under_clause_length = 0;
+	long stats_over_clause_length = 0;
+	long stats_under_clauses = 0;
+	long stats_over_clauses = 0;
+	long stats_line_intersection_skips_under = 0;
+	long stats_line_intersection_skips_over = 0;
 
 	void printStats() {
 		printf("Convex hull %d: ", getID());
@@ -285,29 +285,6 @@ private:
 		
 	}
 };
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_bounds_skips_under = 0;
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_bounds_skips_over = 0;
-
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_line_intersection_skips_under = 0;
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_line_intersection_skips_over = 0;
-
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_propagations = 0;
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_bound_checks = 0;
-
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_under_clause_length = 0;
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_over_clause_length = 0;
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_under_clauses = 0;
-template<unsigned int D, class T>
-long ConvexHullDetector<D, T>::stats_over_clauses = 0;
 
 template<unsigned int D, class T>
 ConvexHullDetector<D, T>::ConvexHullDetector(int detectorID, PointSet<D, T> & under, PointSet<D, T> & over,
@@ -474,10 +451,6 @@ void ConvexHullDetector<D, T>::buildReason(Lit p, vec<Lit> & reason, CRef marker
 template<unsigned int D, class T>
 bool ConvexHullDetector<D, T>::propagate(vec<Lit> & conflict) {
 	
-	static int iter = 0;
-	if (++iter == 5764) {
-		int a = 1;
-	}
 	stats_propagations++;
 	over_hull->update();
 	under_hull->update();
@@ -494,7 +467,7 @@ bool ConvexHullDetector<D, T>::propagate(vec<Lit> & conflict) {
 	 printf("\n");*/
 
 #ifndef NDEBUG
-	cout << "Round " << iter << ", " << getID() << ":\n";
+	cout << "Round " << stats_propagations << ", " << getID() << ":\n";
 	cout << "enabled_" << getID() << " = [";
 	for (int i = 0; i < under.size(); i++) {
 		if (under.pointEnabled(i)) {
@@ -1251,10 +1224,6 @@ void ConvexHullDetector<D, T>::buildConvexNotIntersectsReason2d(ConvexPolygon<2,
 	 printf("\n");*/
 	/*
 
-	 static int iter = 0;
-	 if(++iter==18){
-	 int a=1;
-	 }
 	 */
 
 	assert(!h1.intersects(h2, inclusive));
@@ -1286,9 +1255,9 @@ void ConvexHullDetector<D, T>::buildConvexNotIntersectsReason2d(ConvexPolygon<2,
 	//or some disabled point in h2 that is to the left of the leftmost point in h2 must be enabled.
 	
 	//Note: It may be possible to improve on this analysis!
-	static std::vector<std::pair<Point<2, T>, T>> projection;
+	static thread_local std::vector<std::pair<Point<2, T>, T>> projection;
 	projection.clear();
-	static std::vector<std::pair<Point<2, T>, T>> projection2;
+	static thread_local std::vector<std::pair<Point<2, T>, T>> projection2;
 	projection2.clear();
 	bool found = findSeparatingAxis2d(h1, h2, over, projection, projection2, inclusive);
 	assert(found);
@@ -41,14 +41,14 @@ class LineSegment;
 template<unsigned int D, class T>
 class ConvexPolygon: public Polygon<D, T> {
 public:
-	static long stats_triangle_avoided;
-	static long stats_bounds_avoided;
-	static long stats_split_checks;
-	static long stats_contain_checks;
-	static long stats_split_full_checks;
-	static long stats_split_checks_depths;
-	static long stats_bounds_intersections_avoided;
-	static long stats_intersections;
+	static thread_local long stats_triangle_avoided;
+	static thread_local long stats_bounds_avoided;
+	static thread_local long stats_split_checks;
+	static thread_local long stats_contain_checks;
+	static thread_local long stats_split_full_checks;
+	static thread_local long stats_split_checks_depths;
+	static thread_local long stats_bounds_intersections_avoided;
+	static thread_local long stats_intersections;
 	ConvexPolygon() :
 			Polygon<D, T>() {
 		
@@ -133,23 +133,23 @@ private:
 };
 
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_triangle_avoided = 0;
+thread_local long ConvexPolygon<D, T>::stats_triangle_avoided = 0;
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_bounds_avoided = 0;
+thread_local long ConvexPolygon<D, T>::stats_bounds_avoided = 0;
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_bounds_intersections_avoided = 0;
+thread_local long ConvexPolygon<D, T>::stats_bounds_intersections_avoided = 0;
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_split_checks = 0;
+thread_local long ConvexPolygon<D, T>::stats_split_checks = 0;
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_contain_checks = 0;
+thread_local long ConvexPolygon<D, T>::stats_contain_checks = 0;
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_split_full_checks = 0;
+thread_local long ConvexPolygon<D, T>::stats_split_full_checks = 0;
 
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_split_checks_depths = 0;
+thread_local long ConvexPolygon<D, T>::stats_split_checks_depths = 0;
 
 template<unsigned int D, class T>
-long ConvexPolygon<D, T>::stats_intersections = 0;
+thread_local long ConvexPolygon<D, T>::stats_intersections = 0;
 
 /**
  * A triangle defined by three vertices
@@ -385,10 +385,6 @@ template<unsigned int D, class T>
 bool ConvexPolygon<D, T>::contains(const Point<D, T> & point, bool inclusive) {
 	return contains(point, nullptr, inclusive);
 	/*	//stats_contain_checks++;
-	 static int iter = 0;
-	 if(++iter==309222){
-	 int a=1;
-	 }
 	 if(this->size()==1){
 	 if(inclusive){
 	 return (*this)[0]==point;
@@ -1132,10 +1128,6 @@ bool ConvexPolygon<D, T>::edgesIntersectLine2d(LineSegment<2, T> & check, NConve
 template<unsigned int D, class T>
 bool ConvexPolygon<D, T>::intersects2d(Shape<2, T> & shape, NConvexPolygon<2, T> * polygon_out_this,
 		NConvexPolygon<2, T> * polygon_out_other, bool inclusive, bool ignore_vertices) {
-	static int iter = 0;
-	if (++iter == 3) {
-		int a = 1;
-	}
 	if (this->size() == 0)
 		return false;
 	
@@ -1357,10 +1349,6 @@ bool ConvexPolygon<D, T>::intersects2d(Shape<2, T> & shape, NConvexPolygon<2, T>
 		return r;
 		
 	} else if (shape.getType() == CONVEX_POLYGON) {
-		static int iterp = 0;
-		if (++iterp == 9637275) {
-			int a = 1;
-		}
 		
 		ConvexPolygon<2, T> & c = (ConvexPolygon<2, T>&) shape;
 		if (c.size() < this->size()) {
@@ -1749,7 +1737,7 @@ bool ConvexPolygon<D, T>::intersects2d(Shape<2, T> & shape, NConvexPolygon<2, T>
 					polygon_out_other->clear();
 				}
 				
-				std::cout << "Failed to find intersecting polygon for intersection " << iterp << ", aborting.\n";
+				std::cout << "Failed to find intersecting polygon for intersection, aborting.\n";
 				if (inclusive)
 					std::cout << "(inclusive)\n";
 				if (ignore_vertices)
@@ -1830,14 +1818,14 @@ void NConvexPolygon<D, T>::reorderVertices2d() {
 		}
 	};
 	//this should ideally be avoided...
-	static std::vector<int> points_clockwise;
+	static thread_local std::vector<int> points_clockwise;
 	points_clockwise.clear();
 	for (int i = 0; i < vertices.size(); i++) {
 		points_clockwise.push_back(i);
 	}
 	std::sort(points_clockwise.begin(), points_clockwise.end(), clockwise_lt(vertices, centerX, centerY));
 	//do this in place later
-	static std::vector<Point<2, T>> oldPoints;
+	static thread_local std::vector<Point<2, T>> oldPoints;
 	oldPoints.clear();
 	for (int i = 0; i < vertices.size(); i++) {
 		oldPoints.push_back(vertices[i]);
@@ -22,6 +22,7 @@
 #include "GraphTheory.h"
 #include "monosat/dgl/FloydWarshall.h"
 #include "monosat/dgl/DijkstraAllPairs.h"
+#include "monosat/dgl/IncrementalAllPairs.h"
 using namespace Monosat;
 template<typename Weight>
 AllPairsDetector<Weight>::AllPairsDetector(int _detectorID, GraphTheorySolver<Weight> * _outer, DynamicGraph<Weight> &_g,
@@ -31,13 +32,19 @@ AllPairsDetector<Weight>::AllPairsDetector(int _detectorID, GraphTheorySolver<We
 	
 	positiveReachStatus = new AllPairsDetector<Weight>::ReachStatus(*this, true);
 	negativeReachStatus = new AllPairsDetector<Weight>::ReachStatus(*this, false);
-	if (allpairsalg == AllPairsAlg::ALG_FLOYDWARSHALL) {
+	if (outer->config.allpairs_alg == AllPairsAlg::ALG_FLOYDWARSHALL) {
 		underapprox_reach_detector = new FloydWarshall<Weight,AllPairsDetector<Weight>::ReachStatus>(_g,
 				*(positiveReachStatus), 1);
 		overapprox_reach_detector = new FloydWarshall<Weight,AllPairsDetector<Weight>::ReachStatus>(_antig,
 				*(negativeReachStatus), -1);
 		underapprox_path_detector = underapprox_reach_detector;
-	}/*else if (allpairsalg==ALG_THORUP_ALLPAIRS){
+	} else if (outer->config.allpairs_alg == AllPairsAlg::ALG_INCREMENTAL_ALLPAIRS) {
+		underapprox_reach_detector = new IncrementalAllPairs<Weight,AllPairsDetector<Weight>::ReachStatus>(_g,
+				*(positiveReachStatus), 1);
+		overapprox_reach_detector = new IncrementalAllPairs<Weight,AllPairsDetector<Weight>::ReachStatus>(_antig,
+				*(negativeReachStatus), -1);
+		underapprox_path_detector = underapprox_reach_detector;
+	}/*else if (outer->config.allpairs_alg==ALG_THORUP_ALLPAIRS){
 	 positive_reach_detector = new DynamicConnectivity<AllPairsDetector<Weight>::ReachStatus>(_g,*(positiveReachStatus),1);
 	 negative_reach_detector = new DynamicConnectivity<AllPairsDetector<Weight>::ReachStatus>(_antig,*(negativeReachStatus),-1);
 	 positive_path_detector = positive_reach_detector;
@@ -174,10 +181,6 @@ template<typename Weight>
 void AllPairsDetector<Weight>::buildReachReason(int source, int to, vec<Lit> & conflict) {
 	//drawFull();
 	AllPairs & d = *underapprox_path_detector;
-	static int iter = 0;
-	if (++iter == 3) {
-		int a = 1;
-	}
 	
 	double starttime = rtime(2);
 	d.update();
@@ -195,20 +198,24 @@ void AllPairsDetector<Weight>::buildReachReason(int source, int to, vec<Lit> & c
 	d.getPath(source, to, tmp_path);
 	//if(opt_learn_reaches ==0 || opt_learn_reaches==2)
 	{
-		int u = to;
-		
-		//while(( p = d.previous(u)) != -1){
-		for (int i = tmp_path.size() - 2; i >= 0; i--) {
-			int edge_id = tmp_path[i];
-			int p = outer->edge_list[edge_id].from;
-			
+		//the path is a sequence of nodes; find an enabled edge between each consecutive pair
+		for (int i = tmp_path.size() - 1; i > 0; i--) {
+			int u = tmp_path[i];
+			int p = tmp_path[i - 1];
+			if (p == u)
+				continue;
+			int edge_id = -1;
+			for (int k = 0; k < g_under.nIncident(p); k++) {
+				if (g_under.incident(p, k).node == u && g_under.edgeEnabled(g_under.incident(p, k).id)) {
+					edge_id = g_under.incident(p, k).id;
+					break;
+				}
+			}
+			assert(edge_id >= 0);
 			Var e = outer->getEdgeVar(edge_id);
-			lbool val = outer->value(e);
 			assert(outer->value(e)==l_True);
 			
 			conflict.push(mkLit(e, true));
-			u = p;
-			
 		}
 	}
 	outer->num_learnt_paths++;
@@ -219,8 +226,6 @@ void AllPairsDetector<Weight>::buildReachReason(int source, int to, vec<Lit> & c
 }
 template<typename Weight>
 void AllPairsDetector<Weight>::buildNonReachReason(int source, int node, vec<Lit> & conflict) {
-	static int it = 0;
-	++it;
 	int u = node;
 	//drawFull( non_reach_detectors[detector]->getSource(),u);
 	//assert(outer->dbg_distance( source,u));
@@ -510,7 +515,7 @@ Lit AllPairsDetector<Weight>::decide() {
 					assert(overapprox_reach_detector->distance(s, j) <= min_dist);//else we would already be in conflict before this decision was attempted!
 					if (underapprox_reach_detector->distance(s, j) > min_dist) {
 						//then lets try to connect this
-						static vec<bool> print_path;
+						static thread_local vec<bool> print_path;
 						
 						assert(overapprox_reach_detector->connected(s, j));		//Else, we would already be in conflict
 						int p = j;
@@ -208,8 +208,6 @@ void ConnectedComponentsDetector<Weight>::buildMinComponentsTooLowReason(int min
 }
 template<typename Weight>
 void ConnectedComponentsDetector<Weight>::buildMinComponentsTooHighReason(int min_components, vec<Lit> & conflict) {
-	static int it = 0;
-	++it;
 	
 	//drawFull( non_reach_detectors[detector]->getSource(),u);
 	//assert(outer->dbg_distance( source,u));
@@ -358,7 +356,7 @@ void ConnectedComponentsDetector<Weight>::buildNodesNotConnectedReason(int sourc
 	outer->cutGraph.clearHistory();
 	outer->stats_mc_calls++;
 	/*	if(opt_conflict_min_cut){
-	 if(mincutalg!= MinCutAlg::ALG_EDKARP_ADJ){
+	 if(outer->config.mincut_alg!= MinCutAlg::ALG_EDKARP_ADJ){
 	 //ok, set the weights for each edge in the cut graph.
 	 //Set edges to infinite weight if they are undef or true, and weight 1 otherwise.
 	 for(int u = 0;u<outer->cutGraph.nodes();u++){
@@ -32,14 +32,14 @@ CycleDetector<Weight>::CycleDetector(int _detectorID, GraphTheorySolver<Weight>
 	directed_acyclic_lit = lit_Undef;
 	
 
-	if(cyclealg==CycleAlg::ALG_DFS_CYCLE){
+	if(outer->config.cycle_alg==CycleAlg::ALG_DFS_CYCLE){
 		underapprox_directed_cycle_detector = new DFSCycle<Weight,true,true>(g_under, detect_directed_cycles, 1);
 		overapprox_directed_cycle_detector = new DFSCycle<Weight,true,true>(g_over, detect_directed_cycles, 1);
 
 		overapprox_undirected_cycle_detector=overapprox_directed_cycle_detector;
 		underapprox_undirected_cycle_detector=underapprox_directed_cycle_detector;
 
-	}else if(cyclealg==CycleAlg::ALG_PK_CYCLE){
+	}else if(outer->config.cycle_alg==CycleAlg::ALG_PK_CYCLE){
 		underapprox_directed_cycle_detector = new PKToplogicalSort<Weight>(g_under,  1);
 		overapprox_directed_cycle_detector = new PKToplogicalSort<Weight>(g_over,  1);
 
@@ -168,7 +168,6 @@ void CycleDetector<Weight>::buildReason(Lit p, vec<Lit> & reason, CRef marker) {
 }
 template<typename Weight>
 bool CycleDetector<Weight>::propagate(vec<Lit> & conflict) {
-	static int it = 0;
 /*	if(++it==687){
 		g_under.drawFull();
 		int a=1;
@@ -92,6 +92,15 @@ public:
 	virtual bool propagate(vec<Lit> & conflict	, bool backtrackOnly, Lit & conflictLit){
 		return propagate(conflict);
 	}
+	//True if updateApproximations() may be called concurrently with the updateApproximations() of other detectors.
+	virtual bool supportsParallelUpdate(){
+		return false;
+	}
+	//Bring the under and over approximate graph algorithms up to date, without assigning or enqueueing any literals.
+	//This only reads from the graphs and the solver's assignment; propagate() must still be called afterward.
+	virtual void updateApproximations(){
+
+	}
 
 	virtual void buildReason(Lit p, vec<Lit> & reason, CRef marker)=0;
 	virtual bool checkSatisfied()=0;
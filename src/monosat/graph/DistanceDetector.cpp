@@ -25,6 +25,7 @@
 #include "monosat/dgl/EdmondsKarpAdj.h"
 #include "monosat/dgl/KohliTorr.h"
 #include "monosat/dgl/Dinics.h"
+#include "monosat/dgl/PushRelabel.h"
 #include <monosat/graph/DistanceDetector.h>
 #include <monosat/graph/GraphTheory.h>
 //#include "monosat/dgl/UnweightedDistance.h"
@@ -41,7 +42,7 @@ DistanceDetector<Weight>::DistanceDetector(int _detectorID, GraphTheorySolver<We
 	constraintsBuilt = -1;
 	first_reach_var = var_Undef;
 	stats_pure_skipped = 0;
-	if (distalg == DistAlg::ALG_SAT) {
+	if (outer->config.dist_alg == DistAlg::ALG_SAT) {
 		positiveReachStatus = nullptr;
 		negativeReachStatus = nullptr;
 
@@ -71,7 +72,7 @@ DistanceDetector<Weight>::DistanceDetector(int _detectorID, GraphTheorySolver<We
 	negativeReachStatus = new DistanceDetector<Weight>::ReachStatus(*this, false);
 	
 	//select the unweighted distance detectors
-	if (distalg == DistAlg::ALG_DISTANCE) {
+	if (outer->config.dist_alg == DistAlg::ALG_DISTANCE) {
 		if (outer->all_edges_unit) {
 			if (!opt_encode_dist_underapprox_as_sat)
 				underapprox_unweighted_distance_detector = new UnweightedBFS<Weight,typename DistanceDetector<Weight>::ReachStatus>(from,
@@ -97,7 +98,7 @@ DistanceDetector<Weight>::DistanceDetector(int _detectorID, GraphTheorySolver<We
 		
 		/*	if(opt_conflict_shortest_path)
 		 reach_detectors.last()->positive_dist_detector = new Dijkstra<PositiveEdgeStatus>(from,g);*/
-	} else if (distalg == DistAlg::ALG_RAMAL_REPS) {
+	} else if (outer->config.dist_alg == DistAlg::ALG_RAMAL_REPS) {
 		if (!opt_encode_dist_underapprox_as_sat){
 			 underapprox_unweighted_distance_detector = new UnweightedRamalReps<Weight,
 					typename DistanceDetector<Weight>::ReachStatus>(from, _g, *(positiveReachStatus), 0);
@@ -135,22 +136,24 @@ DistanceDetector<Weight>::DistanceDetector(int _detectorID, GraphTheorySolver<We
 	
 
 	if (opt_conflict_min_cut) {
-		if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+		if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_DYN) {
 			conflict_flow = new EdmondsKarpDynamic<int64_t>(outer->cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_ADJ) {
 			conflict_flow = new EdmondsKarpAdj<int64_t>(outer->cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ) {
 			conflict_flow = new Dinitz<int64_t>(outer->cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 			//link-cut tree currently only supports ints
 			conflict_flow = new Dinitz<int64_t>(outer->cutGraph,  source, 0);
 			
-		} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_KOHLI_TORR) {
 			if (opt_use_kt_for_conflicts) {
 				conflict_flow = new KohliTorr<int64_t>(outer->cutGraph, source, 0,
 						opt_kt_preserve_order);
 			} else
 				conflict_flow = new EdmondsKarpDynamic<int64_t>(outer->cutGraph,  source, 0);
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_PUSH_RELABEL) {
+			conflict_flow = new PushRelabel<int64_t>(outer->cutGraph,  source, 0);
 		} else {
 			conflict_flow = new EdmondsKarpAdj<int64_t>(outer->cutGraph,  source, 0);
 		}
@@ -578,13 +581,9 @@ void DistanceDetector<Weight>::buildUnweightedDistanceLEQReason(int node, vec<Li
 }
 template<typename Weight>
 void DistanceDetector<Weight>::buildUnweightedDistanceGTReason(int node, int within_steps, vec<Lit> & conflict) {
-	static int it = 0;
 	stats_unweighted_gt_reasons++;
 	stats_over_conflicts++;
 	double starttime = rtime(2);
-	if(++it ==14){
-		int a=1;
-	}
 
 	int u = node;
 	bool reaches = overapprox_unweighted_distance_detector->connected(node);
@@ -781,15 +780,23 @@ void DistanceDetector<Weight>::preprocess() {
 
 
 
+template<typename Weight>
+void DistanceDetector<Weight>::updateApproximations() {
+	if (!underapprox_unweighted_distance_detector)
+		return;
+	if (!opt_detect_pure_theory_lits || unassigned_positives > 0) {
+		underapprox_unweighted_distance_detector->update();
+	}
+	if (!opt_detect_pure_theory_lits || unassigned_negatives > 0) {
+		overapprox_unweighted_distance_detector->update();
+	}
+}
+
 template<typename Weight>
 bool DistanceDetector<Weight>::propagate(vec<Lit> & conflict) {
 	if (!underapprox_unweighted_distance_detector)
 		return true;
 	
-	static int iter = 0;
-	if (++iter == 29) { //18303
-		int a = 1;
-	}
 
 	//printf("iter %d\n",iter);
 	bool skipped_positive = false;
@@ -238,6 +238,10 @@ public:
 	}
 	void preprocess();
 	bool propagate(vec<Lit> & conflict);
+	bool supportsParallelUpdate(){
+		return true;
+	}
+	void updateApproximations();
 	void buildUnweightedDistanceLEQReason(int node, vec<Lit> & conflict);
 	void buildUnweightedDistanceGTReason(int node, int within_steps, vec<Lit> & conflict);
 
@@ -421,7 +421,7 @@ class GraphParser: public Parser<B, Solver> {
 		//distance_lt grachID u w var dist is a reach query: var is true if can u reach w in graph g, false otherwise
 
 		++in;
-		static vec<char> tmp;
+		static thread_local vec<char> tmp;
 		int graphID = parseInt(in);
 		int from = parseInt(in);
 		int to = parseInt(in);
@@ -458,7 +458,7 @@ class GraphParser: public Parser<B, Solver> {
 		//distance_lt grachID u w var dist is a reach query: var is true if can u reach w in graph g, false otherwise
 
 		++in;
-		static vec<char> tmp;
+		static thread_local vec<char> tmp;
 		int graphID = parseInt(in);
 		int from = parseInt(in);
 		int to = parseInt(in);
@@ -524,7 +524,7 @@ class GraphParser: public Parser<B, Solver> {
 			//distance_lt grachID u w var dist is a reach query: var is true if can u reach w in graph g, false otherwise
 
 			++in;
-			static vec<char> tmp;
+			static thread_local vec<char> tmp;
 			int graphID = parseInt(in);
 			int reachVar = parseInt(in) - 1;
 
@@ -28,6 +28,7 @@
 #include "monosat/dgl/Reach.h"
 #include "monosat/dgl/Dijkstra.h"
 #include "monosat/dgl/BFS.h"
+#include "monosat/dgl/MultiSourceReach.h"
 
 #include "monosat/core/SolverTypes.h"
 #include "monosat/mtl/Map.h"
@@ -39,11 +40,14 @@
 #include "monosat/dgl/KohliTorr.h"
 #include "monosat/dgl/Dinics.h"
 #include "monosat/dgl/DinicsLinkCut.h"
+#include "monosat/dgl/PushRelabel.h"
+#include "monosat/dgl/GomoryHu.h"
 
 #include "monosat/dgl/Chokepoint.h"
 #include "monosat/graph/WeightedDijkstra.h"
 #include "monosat/graph/GraphTheoryTypes.h"
 #include "monosat/utils/System.h"
+#include "monosat/utils/ThreadPool.h"
 #include "monosat/core/Solver.h"
 
 #include "monosat/graph/AllPairsDetector.h"
@@ -76,6 +80,10 @@ public:
 
 private:
 	Solver * S;
+public:
+	//Algorithm selections and propagation settings, shared with S
+	const SolverConfig & config;
+private:
 	int local_q = 0;
 	bool lazy_backtracking_enabled=false;
 public:
@@ -436,7 +444,7 @@ public:
 
 			Var decision = lazy_trail_head;
 			if(decision!=var_Undef){
-				assert(opt_lazy_backtrack && supportsLazyBacktracking());
+				assert(config.lazy_backtrack && supportsLazyBacktracking());
 				seen[decision]=true;
 				assert(trail[decision].level==lev);
 				Var v = trail[decision].next_var;
@@ -469,7 +477,7 @@ public:
 				assert(l<decisions.size());
 				assert(decisions[l]!=var_Undef);
 			}else if (l==-2){
-				assert(opt_lazy_backtrack && supportsLazyBacktracking());
+				assert(config.lazy_backtrack && supportsLazyBacktracking());
 				assert(lazy_trail_head!=var_Undef);
 			}
 		}*/
@@ -501,6 +509,8 @@ public:
 	vec<DistanceDetector<Weight>*> distance_detectors;
 	vec<WeightedDistanceDetector<Weight>*> weighted_distance_detectors;
 	vec<MaxflowDetector<Weight>*> flow_detectors;
+	//Shared by all of the maximum flow detectors, if opt_maxflow_cut_tree is set
+	GomoryHuTree<Weight> * flow_cut_tree = nullptr;
 	ConnectedComponentsDetector<Weight>* component_detector = nullptr;
 	CycleDetector<Weight> * cycle_detector = nullptr;
 	vec<SteinerDetector<Weight>*> steiner_detectors;
@@ -599,8 +609,16 @@ public:
 	long stats_mc_calls = 0;
 	long stats_propagations_skipped = 0;
 	long stats_lazy_decisions = 0;
+	long stats_parallel_updates = 0;
+	double stats_parallel_update_time = 0;
 	vec<Lit> reach_cut;
 
+	//Worker threads used to update independent detectors concurrently (see opt_parallel_detectors)
+	ThreadPool * detector_pool = nullptr;
+	vec<Detector*> parallel_detectors;
+	//Bit-parallel reachability shared by all reach detectors of each graph (see ReachAlg::ALG_MULTISOURCE)
+	vec<MultiSourceReach<Weight>*> multi_source_reach;
+
 	struct CutStatus {
 		int one = 1;
 		int inf = 0xFFFF;
@@ -641,7 +659,7 @@ public:
 	} propCutStatus;
 
 	GraphTheorySolver(Solver * S_) :
-			S(S_), cutStatus(*this), propCutStatus(*this){
+			S(S_), config(S_->getConfig()), cutStatus(*this), propCutStatus(*this){
 
 		if(opt_record){
 			std::string t = (const char*)opt_record_file;
@@ -720,6 +738,13 @@ public:
 		printf("Conflicts: %ld (lazy conflicts %ld)\n", stats_num_conflicts,stats_num_lazy_conflicts);
 		printf("Reasons: %ld (%f s, avg: %f s)\n", stats_num_reasons, stats_reason_time,
 				(stats_reason_time) / ((double) stats_num_reasons + 1));
+		if (detector_pool) {
+			printf("Parallel detector updates: %ld (%d threads, %f s)\n", stats_parallel_updates,
+					detector_pool->nThreads(), stats_parallel_update_time);
+		}
+		if (flow_cut_tree) {
+			flow_cut_tree->printStats();
+		}
 
 		fflush(stdout);
 
@@ -969,6 +994,9 @@ public:
 	double & getRandomSeed()override{
 		return rnd_seed;
 	}
+	const SolverConfig & getConfig()override{
+		return config;
+	}
 	
 	inline bool edgeWeightDecidable(int edgeID,DetectorComparison op, Weight edgeWeight) {
 		if (! hasBitVector(edgeID))
@@ -1032,6 +1060,15 @@ public:
 	}
 	
 	~GraphTheorySolver() {
+		if (detector_pool) {
+			delete detector_pool;
+		}
+		for (MultiSourceReach<Weight> * r : multi_source_reach) {
+			delete r;
+		}
+		if (flow_cut_tree) {
+			delete flow_cut_tree;
+		}
 	}
 
 	int newNode() {
@@ -1071,7 +1108,7 @@ public:
 
 	bool dbg_propgation(Lit l) {
 #ifndef NDEBUG
-		static vec<Lit> c;
+		static thread_local vec<Lit> c;
 		c.clear();
 		for (int i = 0; i < S->trail.size(); i++) {
 			if (!S->hasTheory(S->trail[i]) || S->getTheoryID(S->trail[i]) != getTheoryIndex())
@@ -1298,8 +1335,6 @@ public:
 
 	//vec<Lit> to_reenqueue;
 	void backtrackUntil(int untilLevel) {
-		static int it = 0;
-		++it;
 		//printf("g%d: backtrack until level %d\n", this->id,untilLevel);
 		//assert(to_reenqueue.size()==0);
 		bool changed = false;
@@ -1386,8 +1421,6 @@ public:
 
 
 	void backtrackUntil(Lit p) {
-		static int it=0;
-		++it;
 		//printf("g%d : backtrack until lit %d\n", this->id,dimacs(p));
 		//need to remove and add edges in the two graphs accordingly.
 		assert(onTrail(var(p))||onLazyTrail(var(p)));
@@ -1469,21 +1502,15 @@ public:
 		return true;
 	}
 	Lit decideTheory() {
-		if (!opt_decide_theories)
+		if (!config.decide_theories)
 			return lit_Undef;
 		double start = rtime(1);
-		static int iter = 0;
-		iter++;
-
-		if(iter==5940){
-			int a=1;
-		}
 		/*if(iter>128451){
 			fflush(stdout);
 			exit(1);
 		}*/
 		dbg_full_sync();
-		if(opt_lazy_backtrack && supportsLazyBacktracking() && opt_lazy_backtrack_decisions && detectors.size()){//the detectors.size() check is a hack, to prevent empty graphs from forcing the decisions that they didn't originally contribute to.
+		if(config.lazy_backtrack && supportsLazyBacktracking() && opt_lazy_backtrack_decisions && detectors.size()){//the detectors.size() check is a hack, to prevent empty graphs from forcing the decisions that they didn't originally contribute to.
 			//assert(n_decisions<=decisionLevel());
 			//printf("g%d lazy dec start: decisionLevel %d, decisions %d\n", this->id, decisionLevel(),n_decisions);
 			//when redeciding a literal, should check to see whether it would still be recomended as a decision by its detector...
@@ -1554,7 +1581,7 @@ public:
 				r->stats_decisions++;
 				stats_decision_time += rtime(1) - start;
 				if(opt_verb>2)
-					printf("g%d: graph decision %d: %d\n", this->getTheoryIndex(), iter, dimacs(l));
+					printf("g%d: graph decision %ld: %d\n", this->getTheoryIndex(), stats_decisions, dimacs(l));
 				return toSolver(l);
 			}
 		}
@@ -1570,7 +1597,6 @@ public:
 
 
 	void buildBVReason(int bvID, Comparison comp, Weight compareTo, vec<Lit> &reason){
-		static int iter = 0;
 		//todo: optimize this for case where bv is statically known to satisfy or fail the constraint...
 		BitVector<Weight> bv = comparator->getBV(bvID);
 		Lit c = getBV_COMP(bvID,-comp,compareTo);
@@ -1736,7 +1762,7 @@ public:
 		g_over.clearChanged();
 		cutGraph.clearChanged();*/
 
-		if(opt_lazy_backtrack){
+		if(config.lazy_backtrack){
 			lazy_backtracking_enabled=true;
 			//currently, lazy backtracking is only supported if _all_ property lits are ground.
 			for (Detector * d:detectors){
@@ -1798,7 +1824,7 @@ public:
 		Var v = var(l);
 
 		int lev = level(v);//level from the SAT solver.
-		if(!opt_lazy_backtrack){
+		if(!config.lazy_backtrack){
 			assert(decisionLevel() <= lev);
 		}
 
@@ -1814,7 +1840,7 @@ public:
 			removeFromTrail(var(l));
 			appendToTrail(l,decisionLevel());
 			return;
-		}else if (opt_lazy_backtrack && value(v)!=l_Undef){
+		}else if (config.lazy_backtrack && value(v)!=l_Undef){
 
 			assert(value(v)!=S->value(toSolver(v)));
 			//this literal was already assigned, and then we backtracked _lazily_ without unassigning it in the theory solver.
@@ -1963,10 +1989,6 @@ public:
 	}
 
 	bool propagateTheory(vec<Lit> & conflict, bool force_propagation) {
-		static int itp = 0;
-		if (++itp == 584) {
-			int a = 1;
-		}
 		dbg_graphsUpToDate();
 		stats_propagations++;
 
@@ -1981,7 +2003,7 @@ public:
 
 		propagations++;
 
-		if (!force_propagation && (propagations % opt_graph_prop_skip != 0)){
+		if (!force_propagation && (propagations % config.graph_prop_skip != 0)){
 			stats_propagations_skipped++;
 
 			return true;
@@ -1993,7 +2015,7 @@ public:
 			return false;
 		}
 
-		if (opt_lazy_backtrack &&
+		if (config.lazy_backtrack &&
 				!lazy_backtracking_enabled && decisionLevel()==0 ){
 			lazy_backtracking_enabled=true;
 			//currently, lazy backtracking is only supported if _all_ property lits are ground.
@@ -2007,6 +2029,10 @@ public:
 		}
 
 
+		if (config.graph_csr) {
+			freezeGraphs();
+		}
+
 		dbg_sync();
 		conflict.clear();
 		//printf("monosat/graph prop %d\n",stats_propagations);
@@ -2044,6 +2070,10 @@ public:
 		dbg_sync();
 		assert(dbg_graphsUpToDate());
 
+		if (config.parallel_detectors > 1 && detectors.size() > 1) {
+			updateDetectorsInParallel();
+		}
+
 		for (int d = 0; d < detectors.size(); d++) {
 			assert(conflict.size() == 0);
 			Lit l = lit_Undef;
@@ -2196,6 +2226,46 @@ public:
 		return true;
 	}
 
+	MultiSourceReach<Weight> * getMultiSourceReach(DynamicGraph<Weight> & g) {
+		for (MultiSourceReach<Weight> * r : multi_source_reach) {
+			if (&r->g == &g)
+				return r;
+		}
+		multi_source_reach.push(new MultiSourceReach<Weight>(g));
+		return multi_source_reach.last();
+	}
+
+	//Bring the graph algorithms of all detectors that support it up to date concurrently.
+	//Only the algorithm updates run in parallel; each detector's propagate() is still called in order afterward,
+	//and finds its algorithms already up to date, so literals and conflicts are produced in the same order as before.
+	//(Re)build the flat adjacency arrays of any graph that has had nodes or edges added since it was last frozen.
+	void freezeGraphs() {
+		g_under.freeze();
+		g_over.freeze();
+		g_under_weights_over.freeze();
+		g_over_weights_under.freeze();
+		cutGraph.freeze();
+	}
+
+	void updateDetectorsInParallel() {
+		parallel_detectors.clear();
+		for (Detector * d : detectors) {
+			if (d->supportsParallelUpdate())
+				parallel_detectors.push(d);
+		}
+		if (parallel_detectors.size() < 2)
+			return;
+		if (!detector_pool) {
+			detector_pool = new ThreadPool(config.parallel_detectors);
+		}
+		double start_time = rtime(2);
+		stats_parallel_updates++;
+		detector_pool->run(parallel_detectors.size(), [this](int i) {
+			parallel_detectors[i]->updateApproximations();
+		});
+		stats_parallel_update_time += rtime(2) - start_time;
+	}
+
 	bool supportsLazyBacktracking(){
 		return lazy_backtracking_enabled;
 	}
@@ -3195,6 +3265,12 @@ public:
 			}
 			return;
 		}
+		if (opt_maxflow_cut_tree) {
+			if (!flow_cut_tree)
+				flow_cut_tree = new GomoryHuTree<Weight>(g_over);
+			flow_cut_tree->addTerminal(from);
+			flow_cut_tree->addTerminal(to);
+		}
 
 		for (int i = 0; i < flow_detectors.size(); i++) {
 			if (flow_detectors[i]->source == from && flow_detectors[i]->target == to) {
@@ -3347,6 +3423,19 @@ public:
 			return -1;
 		return mf->getModel_AcyclicEdgeFlow(edgeID);
 	}
+	//Store the flow assigned to each edge in the model of the maximum flow constraint theoryLit, indexed by edge ID
+	//(store must have room for nEdges() entries). Returns false if theoryLit is not a maximum flow constraint.
+	bool getModel_MaximumFlow_EdgeFlows(Lit theoryLit, Weight * store, bool acyclic){
+		Var v = var(theoryLit);
+		Detector * d= detectors[getDetector(v)];
+		MaxflowDetector<Weight> * mf = dynamic_cast<MaxflowDetector<Weight>*>(d);
+		if(!mf)
+			return false;
+		for(int edgeID = 0;edgeID<nEdges();edgeID++){
+			store[edgeID] = acyclic ? mf->getModel_AcyclicEdgeFlow(edgeID) : mf->getModel_EdgeFlow(edgeID);
+		}
+		return true;
+	}
 	Weight getModel_MinimumSpanningWeight(Lit theoryLit){
 		Var v = var(theoryLit);
 		Detector * d= detectors[getDetector(v)];
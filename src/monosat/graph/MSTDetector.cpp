@@ -35,14 +35,14 @@ MSTDetector<Weight>::MSTDetector(int detectorID, GraphTheorySolver<Weight> * out
 	positiveReachStatus = new MSTDetector<Weight>::MSTStatus(*this, true);
 	negativeReachStatus = new MSTDetector<Weight>::MSTStatus(*this, false);
 	
-	if (mstalg == MinSpanAlg::ALG_KRUSKAL) {
+	if (outer->config.mst_alg == MinSpanAlg::ALG_KRUSKAL) {
 		underapprox_detector = new Kruskal<MSTDetector<Weight>::MSTStatus, Weight>(g,
 				*(positiveReachStatus), 1);
 		overapprox_detector = new Kruskal<MSTDetector<Weight>::MSTStatus, Weight>(antig,
 				*(negativeReachStatus), -1);
 		underapprox_conflict_detector = underapprox_detector;
 		overapprox_conflict_detector = overapprox_detector;
-	} else if (mstalg == MinSpanAlg::ALG_PRIM) {
+	} else if (outer->config.mst_alg == MinSpanAlg::ALG_PRIM) {
 		underapprox_detector = new Prim<MSTDetector<Weight>::MSTStatus, Weight>(g,  *(positiveReachStatus),
 				1);
 		overapprox_detector = new Prim<MSTDetector<Weight>::MSTStatus, Weight>(antig,
@@ -52,7 +52,7 @@ MSTDetector<Weight>::MSTDetector(int detectorID, GraphTheorySolver<Weight> * out
 		overapprox_conflict_detector = new Kruskal<typename MinimumSpanningTree<Weight>::NullStatus, Weight>(antig,
 				 MinimumSpanningTree<Weight>::nullStatus, -1);
 		
-	} else if (mstalg == MinSpanAlg::ALG_SPIRA_PAN) {
+	} else if (outer->config.mst_alg == MinSpanAlg::ALG_SPIRA_PAN) {
 		
 		underapprox_detector = new SpiraPan<MSTDetector<Weight>::MSTStatus, Weight>(g,
 				*(positiveReachStatus), 1); //new SpiraPan<MSTDetector<Weight>::MSTStatus>(_g,*(positiveReachStatus),1);
@@ -300,8 +300,6 @@ void MSTDetector<Weight>::TarjanOLCA(int node, vec<Lit> & conflict) {
 template<typename Weight>
 void MSTDetector<Weight>::buildMinWeightTooLargeReason(Weight & weight, vec<Lit> & conflict) {
 	
-	static int it = 0;
-	++it;
 	
 	//drawFull( non_reach_detectors[detector]->getSource(),u);
 	//assert(outer->dbg_distance( source,u));
@@ -560,11 +558,6 @@ void MSTDetector<Weight>::buildEdgeInTreeReason(int edgeid, vec<Lit> & conflict)
 	Var vt = outer->edge_list[edgeid].v;
 	assert(vt > 0);
 	//assert(outer->value(vt)==l_True);
-	static int it = 0;
-	if (++it == 3) {
-		int a = 1;
-		;
-	}
 	ancestors.clear();
 	ancestors.growTo(g_under.nodes(), -1);
 	
@@ -707,10 +700,6 @@ void MSTDetector<Weight>::preprocess() {
 }
 template<typename Weight>
 bool MSTDetector<Weight>::propagate(vec<Lit> & conflict) {
-	static int it = 0;
-	if (++it == 7) {
-		int a = 1;
-	}
 	if(outer->has_any_bitvector_edges){
 		fprintf(stderr,"MST constraints don't yet support bitvector weight edges, aborting!\n");
 		exit(1);
@@ -38,9 +38,9 @@ MaxflowDetector<Weight>::MaxflowDetector(int _detectorID, GraphTheorySolver<Weig
 	if(from==target){
 		throw std::runtime_error("Maxflow source and target nodes cannot be the same");
 	}
-	MinCutAlg alg = mincutalg;
+	MinCutAlg alg = outer->config.mincut_alg;
 	if(outer->hasBitVectorEdges()){
-		if (alg!= MinCutAlg::ALG_EDKARP_ADJ && alg != MinCutAlg::ALG_KOHLI_TORR){
+		if (alg!= MinCutAlg::ALG_EDKARP_ADJ && alg != MinCutAlg::ALG_KOHLI_TORR && alg != MinCutAlg::ALG_PUSH_RELABEL){
 			printf("Note: falling back on kohli-torr for maxflow, because edge weights are bitvectors\n");
 			alg=MinCutAlg::ALG_KOHLI_TORR;
 		}
@@ -98,6 +98,13 @@ MaxflowDetector<Weight>::MaxflowDetector(int _detectorID, GraphTheorySolver<Weig
 		if (opt_conflict_min_cut_maxflow || opt_adaptive_conflict_mincut)
 			learn_cut = new KohliTorr<Weight>(learn_graph, source, target, opt_kt_preserve_order);
 		
+	} else if (alg == MinCutAlg::ALG_PUSH_RELABEL) {
+		underapprox_detector = new PushRelabel<Weight>(_g, source, target);
+		overapprox_detector = new PushRelabel<Weight>(_antig, source, target);
+		underapprox_conflict_detector = underapprox_detector;
+		overapprox_conflict_detector = overapprox_detector;
+		if (opt_conflict_min_cut_maxflow || opt_adaptive_conflict_mincut)
+			learn_cut = new PushRelabel<Weight>(learn_graph, source, target);
 	} else {
 		underapprox_detector = new EdmondsKarpAdj<Weight>(_g, source, target);
 		overapprox_detector = new EdmondsKarpAdj<Weight>(_antig, source, target);
@@ -486,16 +493,13 @@ void bassert(bool condition) {
 
 template<typename Weight>
 void MaxflowDetector<Weight>::buildMaxFlowTooLowReason(Weight maxflow, vec<Lit> & conflict, bool force_maxflow) {
-	static int it = 0;
-	++it;
-	if (it == 3) {
-		int a = 1;
-	}
 	if(opt_verb>1){
-		printf("Maxflow conflict %d, graph %d\n", it, outer->getTheoryIndex());
+		printf("Maxflow conflict %ld, graph %d\n", stats_over_conflicts, outer->getTheoryIndex());
 	}
 	if(g_over.edges()==0)
 		return;
+	if (!force_maxflow && buildCutTreeReason(maxflow, conflict))
+		return;
 	//printf("%d\n",it);
 	double starttime = rtime(2);
 	if (force_maxflow || opt_conflict_min_cut_maxflow) {
@@ -755,6 +759,67 @@ void MaxflowDetector<Weight>::buildMaxFlowTooLowReason(Weight maxflow, vec<Lit>
 	
 }
 
+/**
+ * If a cut of the shared cut tree separating source from target has (in g_over) capacity less than maxflow, then
+ * at least one of the disabled edges crossing that cut must be enabled for the flow to reach maxflow.
+ * Returns false (leaving conflict unchanged) if there is no such cut, in which case the caller falls back on the
+ * maximum flow.
+ */
+template<typename Weight>
+bool MaxflowDetector<Weight>::buildCutTreeReason(Weight maxflow, vec<Lit> & conflict) {
+	if (!outer->flow_cut_tree || outer->hasBitVectorEdges())
+		return false;
+	double starttime = rtime(2);
+	Weight bound = 0;
+	int cut_id = -1;
+	if (!outer->flow_cut_tree->upperBound(source, target, bound, cut_id) || bound >= maxflow)
+		return false;
+	outer->flow_cut_tree->getCutEdges(cut_id, source, cut_tree_edges);
+	int start_size = conflict.size();
+	for (int edgeID : cut_tree_edges) {
+		if (g_over.edgeEnabled(edgeID) || g_over.isConstant(edgeID))
+			continue;
+		Lit l = mkLit(outer->getEdgeVar(edgeID), false);
+		if (outer->value(l) != l_False) {
+			conflict.shrink(conflict.size() - start_size);
+			return false;
+		}
+		conflict.push(l);
+	}
+	outer->flow_cut_tree->markUseful();
+	bumpConflictEdges(conflict);
+	outer->num_learnt_cuts++;
+	outer->learnt_cut_clause_length += (conflict.size() - 1);
+	stats_over_conflicts++;
+	stats_cut_tree_conflicts++;
+	stats_over_conflict_time += rtime(2) - starttime;
+	return true;
+}
+
+/**
+ * Bound the flow in g_over with the shared cut tree, if that bound alone decides every flow literal that is not
+ * already false (so that the exact maximum flow need not be computed). Returns false otherwise.
+ */
+template<typename Weight>
+bool MaxflowDetector<Weight>::overApproxFromCutTree(Weight & bound) {
+	if (!outer->flow_cut_tree || outer->hasBitVectorEdges())
+		return false;
+	int cut_id = -1;
+	if (!outer->flow_cut_tree->upperBound(source, target, bound, cut_id))
+		return false;
+	for (int j = 0; j < flow_lits.size(); j++) {
+		DistLit & f = flow_lits[j];
+		if (f.max_flow < 0)
+			return false;
+		if (outer->value(f.l) == l_False)
+			continue;
+		if ((f.inclusive && bound >= f.max_flow) || (!f.inclusive && bound > f.max_flow))
+			return false;
+	}
+	outer->flow_cut_tree->markUseful();
+	return true;
+}
+
 template<typename Weight>
 void MaxflowDetector<Weight>::buildReason(Lit p, vec<Lit> & reason, CRef marker) {
 	
@@ -815,15 +880,27 @@ void MaxflowDetector<Weight>::buildReason(Lit p, vec<Lit> & reason, CRef marker)
 		assert(false);
 	}
 }
+template<typename Weight>
+void MaxflowDetector<Weight>::updateApproximations() {
+	//maxFlow() caches its result until the graph is next modified, so propagate() will not recompute it
+	if (flow_lits.size() == 0 || g_under.outfile || g_over.outfile) {
+		return;
+	}
+	if (underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0)) {
+		underapprox_detector->maxFlow();
+	}
+	if (overapprox_detector && !outer->flow_cut_tree && (!opt_detect_pure_theory_lits || unassigned_negatives > 0)) {
+		overapprox_detector->maxFlow();
+	}
+}
+
 template<typename Weight>
 bool MaxflowDetector<Weight>::propagate(vec<Lit> & conflict, bool backtrackOnly, Lit & conflictLit) {
 	if (flow_lits.size() == 0) {
 		return true;
 	}
-	static int iter1 = 0;
-	if (++iter1 == 79) {
-		int a = 1;
-	}
+	static thread_local int iter1 = 0;
+	iter1++;
 
 	if (g_under.outfile) {
 		fprintf(g_under.outfile, "iter %d\n", iter1);
@@ -857,8 +934,11 @@ bool MaxflowDetector<Weight>::propagate(vec<Lit> & conflict, bool backtrackOnly,
 		double startunreachtime = rtime(2);
 		stats_over_updates++;
 		computed_over=true;
-		over_maxflow = overapprox_detector->maxFlow();
-		assert(over_maxflow == overapprox_conflict_detector->maxFlow());
+		if (!overApproxFromCutTree(over_maxflow)) {
+			over_maxflow = overapprox_detector->maxFlow();
+			assert(over_maxflow == overapprox_conflict_detector->maxFlow());
+		} else
+			stats_cut_tree_skips++;
 		double unreachUpdateElapsed = rtime(2) - startunreachtime;
 		stats_over_update_time += unreachUpdateElapsed;
 	} else
@@ -900,7 +980,7 @@ bool MaxflowDetector<Weight>::propagate(vec<Lit> & conflict, bool backtrackOnly,
 					//do nothing
 				} else if (outer->value(l) == l_Undef) {
 					//trail.push(Assignment(false,false,detectorID,0,var(l)));
-					outer->enqueue(~l, underprop_marker);
+					outer->enqueue(~l, overprop_marker);
 
 				} else if (outer->value(l) == l_True) {
 					stats_total_prop_time += rtime(2)-start_prop_time;
@@ -949,7 +1029,7 @@ bool MaxflowDetector<Weight>::propagate(vec<Lit> & conflict, bool backtrackOnly,
 					//do nothing
 				} else if (outer->value(l) == l_Undef) {
 					//trail.push(Assignment(false,false,detectorID,0,var(l)));
-					outer->enqueue(~l, underprop_marker);
+					outer->enqueue(~l, overprop_marker);
 					//should also enqueue that the flow is >= under->flow, and <= over->flow...
 				} else if (outer->value(l) == l_True) {
 					stats_total_prop_time += rtime(2)-start_prop_time;
@@ -1225,7 +1305,7 @@ void MaxflowDetector<Weight>::collectDisabledEdges() {
 
 template<typename Weight>
 void MaxflowDetector<Weight>::collectChangedEdges() {
-	if(!(opt_conflict_min_cut_maxflow || opt_decide_theories))
+	if(!(opt_conflict_min_cut_maxflow || outer->config.decide_theories))
 		return;
 
 	dbg_decisions();
@@ -1239,7 +1319,7 @@ void MaxflowDetector<Weight>::collectChangedEdges() {
 	std::vector<int> & changed_edges = overapprox_conflict_detector->getChangedEdges();
 
 
-	if (opt_decide_theories &&  opt_rnd_order_graph_decisions) {
+	if (outer->config.decide_theories &&  opt_rnd_order_graph_decisions) {
 		/*			static vec<int> tmp_changed;
 		 tmp_changed.clear();
 		 for(int edge:changed_edges):
@@ -1251,13 +1331,11 @@ void MaxflowDetector<Weight>::collectChangedEdges() {
 
 	//need to deal with changes to bv edge weights, also!
 	for (int j = changed_edges.size() - 1; j >= 0; j--) {
-		static int iter = 0;
-		++iter;
 		int edgeid = changed_edges[j];
 		if(opt_theory_internal_vsids){
 			insertEdgeOrder(edgeid);
 		}
-		if(opt_decide_theories){
+		if(outer->config.decide_theories){
 		//if (!is_potential_decision[edgeid]) {
 			Lit l = mkLit(outer->getEdgeVar(edgeid), false);
 			if((outer->decidable(l) || outer->level(var(l))>0) || (outer->edgeWeightDecidable(edgeid, DetectorComparison::geq,  overapprox_conflict_detector->getEdgeFlow(edgeid) )) ){
@@ -1343,11 +1421,6 @@ void MaxflowDetector<Weight>::collectChangedEdges() {
 template<typename Weight>
 void MaxflowDetector<Weight>::dbg_decisions() {
 #ifndef NDEBUG
-	static int iter = 0;
-	++iter;
-	if (iter == 911) {
-		int a = 1;
-	}
 	//printf("Potential Decisions %d: ",iter);
 	/*for (int edgeID = 0; edgeID < g_under.edges(); edgeID++) {
 		
@@ -1435,7 +1508,7 @@ void MaxflowDetector<Weight>::undecideEdgeWeight(int edgeid){
 	if(opt_theory_internal_vsids){
 		insertEdgeOrder(edgeid);
 	}
-	if(!opt_decide_theories)
+	if(!outer->config.decide_theories)
 		return;
 	if((outer->hasBitVector(edgeid) || is_potential_decision[edgeid]) && !in_decision_q[edgeid]){
 
@@ -1474,10 +1547,8 @@ void MaxflowDetector<Weight>::undecideEdgeWeight(int edgeid){
 
 template<typename Weight>
 void MaxflowDetector<Weight>::undecide(Lit l) {
-	static int iter = 0;
 
 	if(outer->isEdgeVar(var(l))){
-		++iter;
 		int edgeid = outer->getEdgeID(var(l));
 		undecideEdgeWeight(edgeid);
 
@@ -1502,10 +1573,6 @@ void MaxflowDetector<Weight>::suggestDecision(Lit l){
 
 template<typename Weight>
 Lit MaxflowDetector<Weight>::decide() {
-	static int it = 0;
-	if (++it == 22) {
-		int a = 1;
-	}
 	double startdecidetime = rtime(2);
 	auto * over = overapprox_conflict_detector;
 	auto * under = underapprox_conflict_detector;
@@ -1776,7 +1843,7 @@ Lit MaxflowDetector<Weight>::decide() {
 				assert(over_flow >= required_flow);
 				
 #ifndef NDEBUG
-				static vec<bool> dbg_expect;
+				static thread_local vec<bool> dbg_expect;
 				int dbg_count = 0;
 				dbg_expect.clear();
 				dbg_expect.growTo(g_under.edges());
@@ -71,6 +71,9 @@ public:
 	double stats_flow_calc_time = 0;
 	double stats_flow_recalc_time = 0;
 	double stats_redecide_time = 0;
+	long stats_cut_tree_skips = 0;
+	long stats_cut_tree_conflicts = 0;
+	std::vector<int> cut_tree_edges;
 
 	Lit last_decision_lit = lit_Undef;
 
@@ -137,10 +140,16 @@ public:
 
 
 	bool propagate(vec<Lit> & conflict, bool backtrackOnly, Lit & conflictLit);
+	bool supportsParallelUpdate(){
+		return true;
+	}
+	void updateApproximations();
 	void buildMaxFlowTooHighReason(Weight flow, vec<Lit> & conflict);
 	Lit findFirstReasonTooHigh(Weight flow);
 	Lit findFirstReasonTooLow(Weight flow);
 	void buildMaxFlowTooLowReason(Weight flow, vec<Lit> & conflict, bool force_maxflow = false);
+	bool buildCutTreeReason(Weight flow, vec<Lit> & conflict);
+	bool overApproxFromCutTree(Weight & bound);
 	void buildForcedEdgeReason(int reach_node, int forced_edge_id, vec<Lit> & conflict);
 	void buildReason(Lit p, vec<Lit> & reason, CRef marker);
 	bool checkSatisfied();
@@ -155,7 +164,7 @@ public:
 	void printStats() {
 		Detector::printStats();
 		printf("\tTotal Detector Propagation Time: %fs\n",stats_total_prop_time);
-		if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		if (outer->config.mincut_alg == MinCutAlg::ALG_KOHLI_TORR) {
 			KohliTorr<Weight> * kt = (KohliTorr<Weight> *) overapprox_detector;
 			printf(
 					"\tInit Time %f, Decision flow calculations: %ld, (redecide: %f s) flow_calc %f s, flow_discovery %f s, (%ld) (maxflow %f,flow assignment %f),  inits: %ld,re-inits %ld\n",
@@ -163,6 +172,9 @@ public:
 					kt->stats_flow_calcs, kt->stats_flow_time, kt->stats_calc_time, kt->stats_inits, kt->stats_reinits);
 		} else
 			printf("\tDecision flow calculations: %ld\n", stats_decision_calculations);
+		if (outer->flow_cut_tree) {
+			printf("\tCut tree: skipped maxflows %ld, conflicts %ld\n", stats_cut_tree_skips, stats_cut_tree_conflicts);
+		}
 		if(n_stats_priority_decisions>0){
 			printf("\tPriority decisions: %ld\n",n_stats_priority_decisions);
 		}
@@ -43,7 +43,7 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 	underprop_marker = CRef_Undef;
 	overprop_marker = CRef_Undef;
 	forced_edge_marker = CRef_Undef;
-	if (reachalg == ReachAlg::ALG_SAT) {
+	if (outer->config.reach_alg == ReachAlg::ALG_SAT) {
 		//to print out the solution
 		//positive_reach_detector = new ReachDetector::CNFReachability(*this,false);
 		//negative_reach_detector = new ReachDetector::CNFReachability(*this,true);
@@ -78,7 +78,7 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 	 }*/
 	positiveReachStatus = new ReachDetector<Weight>::ReachStatus(*this, true);
 	negativeReachStatus = new ReachDetector<Weight>::ReachStatus(*this, false);
-	if (reachalg == ReachAlg::ALG_BFS) {
+	if (outer->config.reach_alg == ReachAlg::ALG_BFS) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new BFSReachability<Weight,ReachDetector<Weight>::ReachStatus>(from, _g,
 					*(positiveReachStatus), 1);
@@ -94,7 +94,7 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 		underapprox_path_detector = underapprox_detector;
 		overapprox_path_detector = overapprox_reach_detector;
 		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
-	} else if (reachalg == ReachAlg::ALG_DFS) {
+	} else if (outer->config.reach_alg == ReachAlg::ALG_DFS) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new DFSReachability<Weight,ReachDetector<Weight>::ReachStatus>(from, _g,
 					*(positiveReachStatus), 1);
@@ -113,7 +113,7 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 		
 		negative_distance_detector = new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, _antig, Distance<int>::nullStatus, -1);
 		overapprox_path_detector = overapprox_reach_detector;
-	} else if (reachalg == ReachAlg::ALG_DISTANCE) {
+	} else if (outer->config.reach_alg == ReachAlg::ALG_DISTANCE) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new UnweightedBFS<Weight,ReachDetector<Weight>::ReachStatus>(from, _g,
 					*(positiveReachStatus), 1);
@@ -128,7 +128,7 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 		underapprox_path_detector = underapprox_detector;
 		overapprox_path_detector = overapprox_reach_detector;
 		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
-	} else if (reachalg == ReachAlg::ALG_RAMAL_REPS) {
+	} else if (outer->config.reach_alg == ReachAlg::ALG_RAMAL_REPS) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new UnweightedRamalReps<Weight,ReachDetector<Weight>::ReachStatus>(from, _g,
 					*(positiveReachStatus), 1, false);
@@ -147,7 +147,23 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 		}
 		overapprox_path_detector = overapprox_reach_detector;// new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, _antig, Distance<int>::nullStatus, -1);
 		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
-	}/*else if (reachalg==ReachAlg::ALG_THORUP){
+	} else if (outer->config.reach_alg == ReachAlg::ALG_MULTISOURCE) {
+		//reachability from all sources is computed together, by a single bit-parallel traversal per graph
+		underapprox_multi_source = new MultiSourceReachability<Weight,ReachDetector<Weight>::ReachStatus>(from,
+				*outer->getMultiSourceReach(_g), *(positiveReachStatus), 1);
+		if (!opt_encode_reach_underapprox_as_sat) {
+			underapprox_detector = underapprox_multi_source;
+		} else {
+			underapprox_fast_detector = underapprox_multi_source;
+		}
+		overapprox_multi_source = new MultiSourceReachability<Weight,ReachDetector<Weight>::ReachStatus>(from,
+				*outer->getMultiSourceReach(_antig), *(negativeReachStatus), -1);
+		overapprox_reach_detector = overapprox_multi_source;
+		//the shared traversal doesn't record paths, so reasons and decisions use their own (lazily updated) searches
+		underapprox_path_detector = new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, _g, Distance<int>::nullStatus, 1);
+		overapprox_path_detector = new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, _antig, Distance<int>::nullStatus, -1);
+		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
+	}/*else if (outer->config.reach_alg==ReachAlg::ALG_THORUP){
 
 
 	 positive_reach_detector = new DynamicConnectivity<ReachDetector<Weight>::ReachStatus>(_g,*(positiveReachStatus),1);
@@ -179,18 +195,18 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 	if (source == 0)
 		sink = 1;
 	if (opt_reach_detector_combined_maxflow) {
-		if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+		if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_DYN) {
 			conflict_flow = new EdmondsKarpDynamic<int64_t>(outer->cutGraph,  source, sink);
-		} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_ADJ) {
 			conflict_flow = new EdmondsKarpAdj<int64_t>(outer->cutGraph,  source, sink);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ) {
 			conflict_flow = new Dinitz<int64_t>(outer->cutGraph,  source, sink);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 			//link-cut tree currently only supports ints (enforcing this using tempalte specialization...).
 			
 			conflict_flow = new Dinitz<int64_t>(outer->cutGraph,  source, sink);
 			
-		} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_KOHLI_TORR) {
 
 			if (opt_use_kt_for_conflicts) {
 
@@ -198,6 +214,8 @@ ReachDetector<Weight>::ReachDetector(int _detectorID, GraphTheorySolver<Weight>
 						opt_kt_preserve_order);
 			} else
 				conflict_flow = new EdmondsKarpDynamic<int64_t>(outer->cutGraph,  source, sink);
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_PUSH_RELABEL) {
+			conflict_flow = new PushRelabel<int64_t>(outer->cutGraph,  source, sink);
 		} else {
 			conflict_flow = new EdmondsKarpAdj<int64_t>(outer->cutGraph,  source, sink);
 		}
@@ -450,6 +468,11 @@ void ReachDetector<Weight>::addLit(int from, int to, Var outer_reach_var) {
 		reach_lit_map.push(-1);
 	}
 	reach_lit_map[reach_var - first_reach_var] = to;
+	if (underapprox_multi_source) {
+		//only nodes with reach lits need to be reported by the shared reachability computation
+		underapprox_multi_source->addTarget(to);
+		overapprox_multi_source->addTarget(to);
+	}
 	
 	assert(from == source);
 	if (opt_encode_reach_underapprox_as_sat || !underapprox_detector) {
@@ -471,29 +494,31 @@ void ReachDetector<Weight>::addLit(int from, int to, Var outer_reach_var) {
 			for (int i = 0; i < g_under.nodes(); i++) {
 				if (reach_lits[i] != lit_Undef && !conflict_flows[i]) {
 					MaxFlow<int64_t> * conflict_flow_t = nullptr;
-					if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+					if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_DYN) {
 						conflict_flow_t = new EdmondsKarpDynamic< int64_t>(outer->cutGraph,  source,
 								i);
-					} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+					} else if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_ADJ) {
 						
 						conflict_flow_t = new EdmondsKarpAdj< int64_t>(outer->cutGraph,  source, i);
 						
-					} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+					} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ) {
 						
 						conflict_flow_t = new Dinitz< int64_t>(outer->cutGraph,  source, i);
 						
-					} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+					} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 						//link-cut tree currently only supports ints (enforcing this using tempalte specialization...).
 						
 						conflict_flow_t = new Dinitz< int64_t>(outer->cutGraph,  source, i);
 						
-					} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+					} else if (outer->config.mincut_alg == MinCutAlg::ALG_KOHLI_TORR) {
 						if (opt_use_kt_for_conflicts) {
 							conflict_flow_t = new KohliTorr< int64_t>(outer->cutGraph,  source, i,
 									opt_kt_preserve_order);
 						} else
 							conflict_flow_t = new EdmondsKarpDynamic< int64_t>(outer->cutGraph,
 									source, i);
+					} else if (outer->config.mincut_alg == MinCutAlg::ALG_PUSH_RELABEL) {
+						conflict_flow_t = new PushRelabel< int64_t>(outer->cutGraph,  source, i);
 					} else {
 						
 						conflict_flow_t = new EdmondsKarpAdj< int64_t>(outer->cutGraph,  source, i);
@@ -624,11 +649,6 @@ void ReachDetector<Weight>::buildReachReason(int node, vec<Lit> & conflict) {
 }
 template<typename Weight>
 void ReachDetector<Weight>::buildNonReachReason(int node, vec<Lit> & conflict, bool force_maxflow) {
-	static int it = 0;
-	++it;
-	if (it == 4) {
-		int a = 1;
-	}
 	int u = node;
 	stats_over_conflicts++;
 	//drawFull( non_reach_detectors[detector]->getSource(),u);
@@ -891,8 +911,6 @@ void ReachDetector<Weight>::buildNonReachReason(int node, vec<Lit> & conflict, b
  */
 template<typename Weight>
 void ReachDetector<Weight>::buildForcedEdgeReason(int reach_node, int forced_edge_id, vec<Lit> & conflict) {
-	static int it = 0;
-	++it;
 	
 	assert(outer->value(outer->edge_list[forced_edge_id].v)==l_True);
 	Lit edgeLit = mkLit(outer->edge_list[forced_edge_id].v, false);
@@ -910,7 +928,7 @@ void ReachDetector<Weight>::buildForcedEdgeReason(int reach_node, int forced_edg
 	outer->stats_mc_calls++;
 	
 	/*if(opt_conflict_min_cut){
-	 if(mincutalg!= MinCutAlg::ALG_EDKARP_ADJ){
+	 if(outer->config.mincut_alg!= MinCutAlg::ALG_EDKARP_ADJ){
 	 //ok, set the weights for each edge in the cut graph.
 	 //Set edges to infinite weight if they are undef or true, and weight 1 otherwise.
 	 for(int u = 0;u<outer->cutGraph.nodes();u++){
@@ -1062,11 +1080,18 @@ void ReachDetector<Weight>::buildReason(Lit p, vec<Lit> & reason, CRef marker) {
 	}
 }
 template<typename Weight>
-bool ReachDetector<Weight>::propagate(vec<Lit> & conflict) {
-	static int iter = 0;
-	if (++iter == 87) {
-		int a = 1;
+void ReachDetector<Weight>::updateApproximations() {
+	//The reach status callbacks only record changed nodes locally; literals are enqueued later, in propagate()
+	if (underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0)) {
+		underapprox_detector->update();
+	}
+	if (overapprox_reach_detector && (!opt_detect_pure_theory_lits || unassigned_negatives > 0)) {
+		overapprox_reach_detector->update();
 	}
+}
+
+template<typename Weight>
+bool ReachDetector<Weight>::propagate(vec<Lit> & conflict) {
 
 	bool skipped_positive = false;
 	if (underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0)) {
@@ -1407,7 +1432,7 @@ Lit ReachDetector<Weight>::decide() {
 				
 				if (over_reach->connected(j) && !under_reach->connected(j)) {
 					//then lets try to connect this
-					static vec<bool> print_path;
+					static thread_local vec<bool> print_path;
 					to_decide.clear();
 					last_decision_status = over_path->numUpdates();
 					
@@ -27,6 +27,7 @@
 #include "monosat/dgl/Dijkstra.h"
 #include "monosat/dgl/BFS.h"
 #include "monosat/dgl/DFS.h"
+#include "monosat/dgl/MultiSourceReach.h"
 
 #include "monosat/core/SolverTypes.h"
 #include "monosat/mtl/Map.h"
@@ -139,6 +140,9 @@ public:
 				detector(_outer), polarity(_polarity) {
 		}
 	};
+	//Set only when using the shared bit-parallel reachability (ReachAlg::ALG_MULTISOURCE)
+	MultiSourceReachability<Weight,ReachStatus> * underapprox_multi_source = nullptr;
+	MultiSourceReachability<Weight,ReachStatus> * overapprox_multi_source = nullptr;
 	ReachStatus *positiveReachStatus = nullptr;
 	ReachStatus *negativeReachStatus = nullptr;
 	MaxFlow<int64_t> * conflict_flow = nullptr;
@@ -269,6 +273,10 @@ public:
 
 	void buildSATConstraints(bool onlyUnderApprox = false, int within_steps = -1);
 	bool propagate(vec<Lit> & conflict);
+	bool supportsParallelUpdate(){
+		return true;
+	}
+	void updateApproximations();
 	void buildReachReason(int node, vec<Lit> & conflict);
 	void buildNonReachReason(int node, vec<Lit> & conflict, bool force_maxflow = false);
 	void buildForcedEdgeReason(int reach_node, int forced_edge_id, vec<Lit> & conflict);
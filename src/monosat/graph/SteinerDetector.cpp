@@ -325,10 +325,6 @@ void SteinerDetector<Weight>::buildReason(Lit p, vec<Lit> & reason, CRef marker)
 }
 template<typename Weight>
 bool SteinerDetector<Weight>::propagate(vec<Lit> & conflict) {
-	static int it = 0;
-	if (++it == 7) {
-		int a = 1;
-	}
 	changed_weights.clear();
 	double startdreachtime = rtime(2);
 	stats_under_updates++;
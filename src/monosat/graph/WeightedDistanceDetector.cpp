@@ -25,6 +25,7 @@
 #include "monosat/dgl/EdmondsKarpAdj.h"
 #include "monosat/dgl/KohliTorr.h"
 #include "monosat/dgl/Dinics.h"
+#include "monosat/dgl/PushRelabel.h"
 #include <monosat/graph/WeightedDistanceDetector.h>
 #include <monosat/graph/GraphTheory.h>
 //#include "monosat/dgl/UnweightedDistance.h"
@@ -59,16 +60,7 @@ WeightedDistanceDetector<Weight>::WeightedDistanceDetector(int _detectorID, Grap
 	positiveDistanceStatus = new WeightedDistanceDetector<Weight>::DistanceStatus(*this, true);
 	negativeDistanceStatus = new WeightedDistanceDetector<Weight>::DistanceStatus(*this, false);
 	
-	if (outer->hasBitVectorEdges()){
-		printf("Note: falling back on Dijkstra for shortest paths, because edge weights are bitvectors\n");
-		//ramel reps doesn't support bvs yet
-		underapprox_weighted_distance_detector =
-		new Dijkstra<Weight, typename WeightedDistanceDetector<Weight>::DistanceStatus>(from, _g,
-				*positiveDistanceStatus, 0);
-		overapprox_weighted_distance_detector = new Dijkstra<Weight, typename WeightedDistanceDetector<Weight>::DistanceStatus>(
-				from, _antig,  *negativeDistanceStatus, 0);
-		underapprox_weighted_path_detector = underapprox_weighted_distance_detector;
-	}else if (  distalg == DistAlg::ALG_RAMAL_REPS) {
+	if (  outer->config.dist_alg == DistAlg::ALG_RAMAL_REPS) {
 
 		underapprox_weighted_distance_detector =
 				new RamalReps<Weight, typename WeightedDistanceDetector<Weight>::DistanceStatus>(from, _g,
@@ -87,22 +79,24 @@ WeightedDistanceDetector<Weight>::WeightedDistanceDetector(int _detectorID, Grap
 	}
 	
 	if (opt_conflict_min_cut) {
-		if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+		if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_DYN) {
 			conflict_flow = new EdmondsKarpDynamic<int64_t>(outer->cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_EDKARP_ADJ) {
 			conflict_flow = new EdmondsKarpAdj<int64_t>(outer->cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ) {
 			conflict_flow = new Dinitz<int64_t>(outer->cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 			//link-cut tree currently only supports ints
 			conflict_flow = new Dinitz<int64_t>(outer->cutGraph,  source, 0);
 			
-		} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_KOHLI_TORR) {
 			if (opt_use_kt_for_conflicts) {
 				conflict_flow = new KohliTorr<int64_t>(outer->cutGraph, source, 0,
 						opt_kt_preserve_order);
 			} else
 				conflict_flow = new EdmondsKarpDynamic<int64_t>(outer->cutGraph,  source, 0);
+		} else if (outer->config.mincut_alg == MinCutAlg::ALG_PUSH_RELABEL) {
+			conflict_flow = new PushRelabel<int64_t>(outer->cutGraph,  source, 0);
 		} else {
 			conflict_flow = new EdmondsKarpAdj<int64_t>(outer->cutGraph,  source, 0);
 		}
@@ -237,10 +231,8 @@ void WeightedDistanceDetector<Weight>::buildDistanceLEQReason(int to, Weight & m
 
 template<typename Weight>
 void WeightedDistanceDetector<Weight>::buildDistanceGTReason(int to, Weight & min_distance, vec<Lit> & conflict, bool strictComparison) {
-	static int it = 0;
 	stats_distance_gt_reasons++;
 	stats_over_conflicts++;
-	++it;
 	double starttime = rtime(2);
 	int u = to;
 	bool reaches = overapprox_weighted_distance_detector->connected(to);
@@ -514,10 +506,6 @@ void WeightedDistanceDetector<Weight>::preprocess() {
 template<typename Weight>
 bool WeightedDistanceDetector<Weight>::propagate(vec<Lit> & conflict) {
 
-	static int iter = 0;
-	if (++iter == 29) { //18303
-		int a = 1;
-	}
 
 	//printf("iter %d\n",iter);
 	bool skipped_positive = false;
@@ -554,9 +542,16 @@ bool WeightedDistanceDetector<Weight>::propagate(vec<Lit> & conflict) {
 	
 	if (opt_rnd_shuffle && weighted_dist_lits.size()) {
 		randomShuffle(rnd_seed, weighted_dist_lits);
+		//reach_lit_map stores positions in weighted_dist_lits, which are needed to build reasons later
+		for (int i = 0; i < weighted_dist_lits.size(); i++) {
+			reach_lit_map[var(weighted_dist_lits[i].l) - first_reach_var].within = i;
+		}
 	}
 	if (opt_rnd_shuffle && weighted_dist_bv_lits.size()) {
 		randomShuffle(rnd_seed, weighted_dist_bv_lits);
+		for (int i = 0; i < weighted_dist_bv_lits.size(); i++) {
+			reach_lit_map[var(weighted_dist_bv_lits[i].l) - first_reach_var].within = i;
+		}
 	}
 
 	//now, check for weighted distance lits
@@ -318,8 +318,6 @@ public:
 		
 		stats_propagations++;
 		
-		static int iter = 0;
-		++iter;
 		double startproptime = rtime(2);
 		
 		//This is wrong! Only need to visit each _clause_ that has any involved literals once per propagation round.
@@ -389,8 +387,6 @@ public:
 			} else if (rhs_val == l_True && overApprox < total) {
 				//conflict
 				assert(pbclause.side != ConstraintSide::Lower);
-				static int iter = 0;
-				++iter;
 				conflict.push(~rhs);
 				buildSumLTReason(clauseID, conflict);
 				dbg_prove(pbclause, conflict);
@@ -1293,10 +1289,6 @@ public:
 		stats_reasons++;
 		
 		int clauseID = reasonMap[marker];
-		static int iter = 0;
-		if (++iter == 13) {
-			int a = 1;
-		}
 		PbClause & pbclause = clauses[clauseID];
 		reason.push(p);
 		if (var(p) == var(pbclause.rhs.lit)) {
@@ -48,7 +48,11 @@ static DoubleOption opt_simp_garbage_frac(_cat, "monosat/simp-gc-frac",
 // Constructor/Destructor:
 
 SimpSolver::SimpSolver() :
-		grow(opt_grow), clause_lim(opt_clause_lim), subsumption_lim(opt_subsumption_lim), simp_garbage_frac(
+		SimpSolver(SolverConfig()) {
+}
+
+SimpSolver::SimpSolver(const SolverConfig & config) :
+		Solver(config), grow(opt_grow), clause_lim(opt_clause_lim), subsumption_lim(opt_subsumption_lim), simp_garbage_frac(
 		opt_simp_garbage_frac), use_asymm(opt_use_asymm), use_rcheck(opt_use_rcheck), use_elim(opt_use_elim), merges(
 		0), asymm_lits(0), eliminated_vars(0), elimorder(1), use_simplification(true), occurs(
 		ClauseDeleted(ca)), elim_heap(ElimLt(n_occ)), bwdsub_assigns(0), n_touched(0) {
@@ -134,8 +138,14 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp) {
 
 	if (result == l_True)
 		result = Solver::solve_();
-	else if (verbosity >= 1)
-		printf("===============================================================================\n");
+	else {
+		if (drat) {
+			conflict.clear();
+			proofFinish(l_False);
+		}
+		if (verbosity >= 1)
+			printf("===============================================================================\n");
+	}
 
 	if (result == l_True)
 		extendModel();
@@ -209,29 +219,45 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l) {
 	subsumption_queue.insert(cr);
 
 	if (c.size() == 2) {
+		if (drat)
+			proofAdd(c, DratWriter::Add, l);
 		removeClause(cr);
 		c.strengthen(l);
 	} else {
 		detachClause(cr, true);
+		//a satisfied clause is removed, rather than strengthened
+		for (int i = 0; i < c.size(); i++) {
+			if (c[i] != l && value(c[i]) == l_True) {
+				removeClause(cr);
+				return true;
+			}
+		}
+		if (drat) {
+			strengthen_tmp.clear();
+			for (int i = 0; i < c.size(); i++)
+				strengthen_tmp.push(c[i]);
+		}
 		int size = c.size();
 		//remove any false lits from this clause
 		for (int i = 0; i < c.size(); i++) {
 			Lit lit = c[i];
-			if (lit != l) {
-				if (value(lit) == l_False) {
-					size--;
-					i--;
-					c.strengthen(lit);    //can do this more efficiently, obviously...
-				} else if (value(lit) == l_True) {
-					size = -1;
-					removeClause(cr);
-					break;
-				}
+			if (lit != l && value(lit) == l_False) {
+				size--;
+				i--;
+				c.strengthen(lit);    //can do this more efficiently, obviously...
 			}
 		}
-		if (size == -1) {
-			return true;
-		} else if (size == 0) {
+		if (drat) {
+			//record the clause without its false literals, and then without l (deleting the clauses it replaces)
+			if (size < strengthen_tmp.size()) {
+				proofAdd(c);
+				proofDelete(strengthen_tmp);
+			}
+			proofAdd(c, DratWriter::Add, l);
+			if (size > 2)
+				proofDelete(c);
+		}
+		if (size == 0) {
 			ok = false;
 			return false;
 		} else if (size == 1) {
@@ -536,6 +562,14 @@ bool SimpSolver::eliminateVar(Var v) {
 			mkElimClause(elimclauses, v, ca[pos[i]]);
 		mkElimClause(elimclauses, ~mkLit(v));
 	}
+	if (drat) {
+		//the resolvents must be in the proof before the clauses they were resolved from are deleted
+		vec<Lit>& resolvent = add_tmp;
+		for (int i = 0; i < pos.size(); i++)
+			for (int j = 0; j < neg.size(); j++)
+				if (merge(ca[pos[i]], ca[neg[j]], v, resolvent))
+					proofAdd(resolvent);
+	}
 	bool all_derived = true;
 	for (int i = 0; i < cls.size(); i++) {
 		all_derived&=ca[cls[i]].derivedClause();
@@ -582,6 +616,8 @@ bool SimpSolver::substitute(Var v, Lit x) {
 			subst_clause.push(var(p) == v ? x ^ sign(p) : p);
 		}
 
+		if (drat)
+			proofAdd(subst_clause);
 		removeClause(cls[i]);
 
 		if (!addClause_(subst_clause))//should this clause be treated as derived?
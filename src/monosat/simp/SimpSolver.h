@@ -36,6 +36,7 @@ public:
 	// Constructor/Destructor:
 	//
 	SimpSolver();
+	SimpSolver(const SolverConfig & config);
 	~SimpSolver();
 
 	// Problem specification:
@@ -66,7 +67,7 @@ public:
 	// Variable mode:
 	//
 	void setFrozen(Var v, bool b); // If a variable is frozen it will not be eliminated.
-	bool isEliminated(Var v) const;
+	bool isEliminated(Var v) const override;
 
 	// Alternative freeze interface (may replace 'setFrozen()'):
 	void    freezeVar (Var v);         // Freeze one variable so it will not be eliminated.
@@ -198,6 +199,7 @@ protected:
 	// Temporaries:
 	//
 	CRef bwdsub_tmpunit;
+	vec<Lit> strengthen_tmp;
 
 	// Main internal methods:
 	//
@@ -0,0 +1,200 @@
+/****************************************************************************************[MappedBuffer.cc]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/utils/MappedBuffer.h"
+#include "monosat/core/BinaryGNF.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Monosat;
+
+MappedBuffer * MappedBuffer::open(const char * filename, int n_threads) {
+	int fd = ::open(filename, O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < 2) {
+		close(fd);
+		return nullptr;
+	}
+	void * mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	//the mapping remains valid after the file is closed
+	close(fd);
+	if (mapped == MAP_FAILED)
+		return nullptr;
+	const unsigned char * bytes = (const unsigned char *) mapped;
+	if ((bytes[0] == 0x1f && bytes[1] == 0x8b) || bytes[0] == BinaryGNF::magic[0]) {
+		//gzip compressed, or binary GNF (which is read through a StreamBuffer by BinaryGNFReader)
+		munmap(mapped, st.st_size);
+		return nullptr;
+	}
+	madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+	if (n_threads <= 0)
+		n_threads = std::max(1u, std::thread::hardware_concurrency());
+	return new MappedBuffer((const char *) mapped, st.st_size, n_threads);
+}
+
+MappedBuffer::MappedBuffer(const char * data, int64_t size, int n_threads) :
+		data(data), size(size) {
+	if (n_threads > 1) {
+		pool = new ThreadPool(n_threads);
+		chunks.resize(n_threads);
+	}
+}
+
+MappedBuffer::~MappedBuffer() {
+	delete pool;
+	munmap((void*) data, size);
+}
+
+bool MappedBuffer::readLine(vec<char> & linebuf) {
+	linebuf.clear();
+	if (pos >= size) {
+		linebuf.push(0);
+		return false;
+	}
+	const char * newline = (const char *) memchr(data + pos, '\n', size - pos);
+	int64_t end = newline ? (newline - data) + 1 : size;
+	int length = end - pos;
+	linebuf.growTo(length + 1);
+	memcpy(linebuf.begin(), data + pos, length);
+	linebuf[length] = 0;
+	pos = end;
+	return newline != nullptr;
+}
+
+bool MappedBuffer::nextClause(const int *& lits, int & n_lits) {
+	if (!pool)
+		return false;
+	if (pos >= window_end) {
+		if (pos >= size)
+			return false;
+		tokenizeWindow();
+	}
+	while (cur_chunk < chunks.size()) {
+		Chunk & chunk = chunks[cur_chunk];
+		while (cur_clause < chunk.starts.size() && chunk.starts[cur_clause] < pos)
+			cur_clause++;
+		if (cur_clause < chunk.starts.size()) {
+			if (chunk.starts[cur_clause] != pos)
+				return false;
+			lits = &chunk.lits[chunk.lit_starts[cur_clause]];
+			n_lits = chunk.lit_starts[cur_clause + 1] - chunk.lit_starts[cur_clause];
+			pos = chunk.ends[cur_clause];
+			cur_clause++;
+			stats_pretokenized_clauses++;
+			return true;
+		}
+		cur_chunk++;
+		cur_clause = 0;
+	}
+	return false;
+}
+
+void MappedBuffer::tokenizeWindow() {
+	//start at the next line, unless the parser is at the start of a line
+	int64_t begin = std::max(pos, window_end);
+	if (begin > 0 && data[begin - 1] != '\n') {
+		const char * newline = (const char *) memchr(data + begin, '\n', size - begin);
+		begin = newline ? (newline - data) + 1 : size;
+	}
+	for (Chunk & chunk : chunks) {
+		chunk.clear();
+		chunk.begin = begin;
+		int64_t end = std::min(size, begin + chunk_size);
+		if (end < size) {
+			const char * newline = (const char *) memchr(data + end, '\n', size - end);
+			end = newline ? (newline - data) + 1 : size;
+		}
+		chunk.end = end;
+		begin = end;
+	}
+	window_end = std::max(begin, pos + 1);
+	cur_chunk = 0;
+	cur_clause = 0;
+	pool->run(chunks.size(), [&](int i) {
+		tokenizeChunk(chunks[i]);
+	});
+}
+
+static inline bool isSpace(char c) {
+	//whitespace, other than newlines
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Record every clause that starts at the beginning of a line (or after the end of another clause on the same line)
+ * and is terminated by a 0 on that line, reading integers exactly as parseInt() does.
+ * Any other line is skipped, to be read by the parser itself.
+ */
+void MappedBuffer::tokenizeChunk(Chunk & chunk) {
+	const char * p = data + chunk.begin;
+	const char * end = data + chunk.end;
+	chunk.lit_starts.push_back(0);
+	while (p < end) {
+		while (p < end && isSpace(*p))
+			p++;
+		while (p < end && (*p == '-' || (*p >= '0' && *p <= '9'))) {
+			const char * start = p;
+			size_t first_lit = chunk.lits.size();
+			bool terminated = false;
+			while (p < end) {
+				while (p < end && isSpace(*p))
+					p++;
+				if (p >= end || *p == '\n')
+					break;
+				bool neg = false;
+				if (*p == '-') {
+					neg = true;
+					p++;
+				} else if (*p == '+') {
+					p++;
+				}
+				if (p >= end || *p < '0' || *p > '9')
+					break;
+				int val = 0;
+				while (p < end && *p >= '0' && *p <= '9')
+					val = val * 10 + (*p++ - '0');
+				if (val == 0) {
+					terminated = true;
+					break;
+				}
+				chunk.lits.push_back(neg ? -val : val);
+			}
+			if (!terminated) {
+				//leave this line to the parser
+				chunk.lits.resize(first_lit);
+				break;
+			}
+			chunk.starts.push_back(start - data);
+			chunk.ends.push_back(p - data);
+			chunk.lit_starts.push_back(chunk.lits.size());
+			while (p < end && isSpace(*p))
+				p++;
+		}
+		const char * newline = (const char *) memchr(p, '\n', end - p);
+		p = newline ? newline + 1 : end;
+	}
+}
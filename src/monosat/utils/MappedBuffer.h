@@ -0,0 +1,133 @@
+/****************************************************************************************[MappedBuffer.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+#ifndef Monosat_MappedBuffer_h
+#define Monosat_MappedBuffer_h
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "monosat/mtl/Vec.h"
+#include "monosat/utils/ThreadPool.h"
+
+namespace Monosat {
+
+/**
+ * A character stream over a memory mapped (uncompressed) file, with the same interface as StreamBuffer,
+ * but without copying the file through zlib.
+ *
+ * Because nearly all of the lines in a large CNF or GNF file are clauses, MappedBuffer also reads clauses
+ * ahead of the parser: the file is split into line-aligned chunks, and the clauses in a window of consecutive
+ * chunks are tokenized into integers in parallel. The parser still reads the file in order, taking the
+ * already tokenized literals whenever it reaches the start of a clause (see readPretokenizedClause()),
+ * and mapping their variables as it goes, so the resulting variable numbering is the same as with StreamBuffer.
+ * Anything that wasn't tokenized in advance (such as clauses that continue over several lines) is read
+ * one character at a time, as usual.
+ */
+class MappedBuffer {
+	const char * data = nullptr;
+	int64_t size = 0;
+	int64_t pos = 0;
+
+	//Clauses tokenized in advance, from one chunk of the current window
+	struct Chunk {
+		int64_t begin = 0;
+		int64_t end = 0;
+		//the i'th clause spans [starts[i],ends[i]), and its literals are lits[lit_starts[i]..lit_starts[i+1]) (excluding the trailing 0)
+		std::vector<int64_t> starts;
+		std::vector<int64_t> ends;
+		std::vector<int> lit_starts;
+		std::vector<int> lits;
+		void clear() {
+			starts.clear();
+			ends.clear();
+			lit_starts.clear();
+			lits.clear();
+		}
+	};
+	std::vector<Chunk> chunks;
+	int64_t window_end = 0;
+	int cur_chunk = 0;
+	int cur_clause = 0;
+	ThreadPool * pool = nullptr;
+
+	MappedBuffer(const char * data, int64_t size, int n_threads);
+	void tokenizeWindow();
+	void tokenizeChunk(Chunk & chunk);
+public:
+	//Bytes per chunk (each chunk is extended to the end of its last line)
+	static const int64_t chunk_size = 1 << 22;
+	int64_t stats_pretokenized_clauses = 0;
+
+	/**
+	 * Map the given file into memory, or return nullptr if it can't be mapped (or is gzip compressed or binary GNF), in which
+	 * case it should be read through a StreamBuffer instead.
+	 * Clauses are tokenized by n_threads threads (0 for one per core); with a single thread, they are
+	 * read as they are parsed, as with StreamBuffer.
+	 */
+	static MappedBuffer * open(const char * filename, int n_threads);
+	~MappedBuffer();
+
+	MappedBuffer(const MappedBuffer &) = delete;
+	MappedBuffer & operator=(const MappedBuffer &) = delete;
+
+	int operator *() const {
+		return (pos >= size) ? EOF : (unsigned char) data[pos];
+	}
+	void operator ++() {
+		pos++;
+	}
+	void operator +=(int n) {
+		assert(n >= 0);
+		pos += n;
+	}
+	int64_t position() const {
+		return pos;
+	}
+
+	/**
+	 * If the clause starting at the current position was tokenized in advance, point lits to its n_lits literals
+	 * (in DIMACS format, without the terminating 0), advance past the clause, and return true.
+	 */
+	bool nextClause(const int *& lits, int & n_lits);
+
+	/**
+	 * Copy the remainder of the current line, including its newline, into linebuf, followed by a 0, and advance past it.
+	 * Returns false if the end of the file was reached before a newline.
+	 */
+	bool readLine(vec<char> & linebuf);
+};
+
+static inline bool isEof(MappedBuffer & in) {
+	return *in == EOF;
+}
+
+//Clauses are only tokenized in advance by a MappedBuffer; see MappedBuffer::nextClause()
+template<class B>
+static inline bool readPretokenizedClause(B & in, const int *& lits, int & n_lits) {
+	return false;
+}
+static inline bool readPretokenizedClause(MappedBuffer & in, const int *& lits, int & n_lits) {
+	return in.nextClause(lits, n_lits);
+}
+
+}
+
+#endif
@@ -0,0 +1,134 @@
+/****************************************************************************************[ThreadPool.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+#ifndef Monosat_ThreadPool_h
+#define Monosat_ThreadPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Monosat {
+
+/**
+ * A small, fixed size pool of worker threads.
+ * Work is submitted in batches of independent jobs, indexed 0..n_jobs-1; run() blocks until the
+ * whole batch has completed. The calling thread also executes jobs, so a pool of n threads
+ * starts only n-1 workers.
+ */
+class ThreadPool {
+	std::vector<std::thread> workers;
+	std::mutex lock;
+	std::condition_variable work_available;
+	std::condition_variable work_finished;
+
+	const std::function<void(int)> * job = nullptr;
+	int n_jobs = 0;
+	std::atomic<int> next_job;
+	int n_active = 0;
+	uint64_t generation = 0;
+	bool stopping = false;
+
+public:
+	explicit ThreadPool(int n_threads) :
+			next_job(0) {
+		for (int i = 1; i < n_threads; i++) {
+			workers.emplace_back([this]() {workerLoop();});
+		}
+	}
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stopping = true;
+		}
+		work_available.notify_all();
+		for (std::thread & t : workers)
+			t.join();
+	}
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool & operator=(const ThreadPool &) = delete;
+
+	int nThreads() const {
+		return workers.size() + 1;
+	}
+
+	/**
+	 * Run f(0)...f(jobs-1), in parallel and in no particular order, returning once all have completed.
+	 * f must be safe to call concurrently with itself for distinct indices.
+	 */
+	void run(int jobs, const std::function<void(int)> & f) {
+		if (jobs <= 0)
+			return;
+		if (workers.empty() || jobs == 1) {
+			for (int i = 0; i < jobs; i++)
+				f(i);
+			return;
+		}
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			//workers that woke up late for the previous batch must leave before the batch is replaced
+			work_finished.wait(guard, [this]() {return n_active == 0;});
+			job = &f;
+			n_jobs = jobs;
+			next_job = 0;
+			generation++;
+		}
+		work_available.notify_all();
+		runJobs();
+		std::unique_lock<std::mutex> guard(lock);
+		work_finished.wait(guard, [this]() {return n_active == 0;});
+		job = nullptr;
+	}
+
+private:
+	void runJobs() {
+		int i;
+		while ((i = next_job++) < n_jobs) {
+			(*job)(i);
+		}
+	}
+
+	void workerLoop() {
+		uint64_t seen = 0;
+		std::unique_lock<std::mutex> guard(lock);
+		while (true) {
+			work_available.wait(guard, [&]() {return stopping || generation != seen;});
+			if (stopping)
+				return;
+			seen = generation;
+			n_active++;
+			guard.unlock();
+			runJobs();
+			guard.lock();
+			if (--n_active == 0)
+				work_finished.notify_all();
+		}
+	}
+};
+
+}
+
+#endif